@@ -0,0 +1,466 @@
+                                                                                                                              /*
+ Copyright Mykola Rabchevskiy 2021.
+ Distributed under the Boost Software License, Version 1.0.
+ (See http://www.boost.org/LICENSE_1_0.txt)
+ ______________________________________________________________________________
+
+  Gnosis::Batch - atomic group of mutations of the Gnosis and associated
+  data storage, optionally written into write-ahead log (see `journal.h`).
+
+  Batch just records operations (encoded in binary form) until `commit()`
+  called. At commit the whole batch checked (all referred entities must
+  exist or be created by preceding operations of the batch) and rejected
+  if check failed, so batch is applied completely or not at all. Checked
+  batch applied and then appended to the journal while holding commit lock
+  of the Gnosis, so snapshots (see Gnosis::Snapshot) never contain part
+  of the batch and journal never contains batch that was not applied.
+  Commit returns when journal frame written according to the journal`
+  synchronization policy; waiting for disk synchronization happens out of
+  the lock, so concurrent commits share single `fdatasync`. Failure of the
+  journal after apply reported by commit as UNSYNCED, not as REJECTED.
+
+  Journal replayed over the graph loaded from the last full save:
+
+    gnosis.load( folder );
+    Gnosis::Batch::replay( path, gnosis, &data );
+
+  or over the restored checkpoint, skipping batches it already contains:
+
+    gnosis.load( folder );
+    Gnosis::Batch::replay( path, gnosis, &data, nullptr, gnosis.checkpointFence() );
+
+  NB: entity created by `Batch.entity()` exists only after commit, so it can
+      be used as argument of the batch operations but not as regular entity.
+
+  NB: glossary is not journaled, so names of the created entities should be
+      saved by the glossary itself.
+
+  2026.10.19 Initial version
+  2026.10.19 Check reserves capacity of segments and syndromes and checks IMMORTAL / IMMUTABLE
+             restrictions, so checked batch can`t fail at apply; failure still reported by commit
+  2026.10.19 `replay(..)` can skip batches contained in the restored checkpoint
+  2026.10.19 Interned string of the PUT operation journaled by its chars
+  2026.10.19 Cargo of the PUT operation journaled packed (see `Data::Cargo::pack(..)`): tag, length
+             and chars of string, so no raw bytes of the process-local handle in the journal
+  2026.10.19 Batch journaled after apply; `commit()` returns Outcome: REJECTED batch changes
+             nothing, UNSYNCED batch applied but journal failed
+________________________________________________________________________________________________________________________________
+                                                                                                                              */
+#ifndef BATCH_H_INCLUDED
+#define BATCH_H_INCLUDED
+
+#include <cstdint>
+#include <cstring>
+
+#include <functional>
+#include <initializer_list>
+#include <map>
+#include <mutex>
+#include <set>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "data.mini.h"
+#include "gnosis.h"
+#include "journal.h"
+#include "random.h"
+
+namespace CoreAGI {
+
+  class Gnosis::Batch: public Gnosis::Local {
+  public:
+
+    enum Op: uint8_t {
+      CREATE = 1, // :entity
+      INCL   = 2, // :entity, sign
+      EXCL   = 3, // :entity, sign
+      SEQ    = 4, // :entity, length, elements
+      FORGET = 5, // :entity, `skip check` flag
+      ABSORB = 6, // :entity, absorbed entity
+      PUT    = 7, // :object, attribute, cargo
+      DROP   = 8  // :object, attribute
+    };
+
+  private:
+
+    struct Record {
+      Op                      op;
+      Identity                a;     // :entity or object
+      Identity                b;     // :sign, absorbed entity or attribute
+      uint8_t                 flag;
+      std::vector< Identity > list;  // :sequence elements
+      Data::Cargo             cargo;
+    };
+
+    Data::Storage*          data;     // :optional data storage
+    Journal*                journal;  // :optional write-ahead log
+    std::vector< uint8_t >  code;     // :encoded operations
+    std::set< Identity >    reserved; // :ID of the entities to be created
+    unsigned                count;    // :number of operations
+    std::string             ERROR;    // :reason of the last failure
+
+    template< typename T > void emit( const T& val ){
+      const uint8_t* p{ reinterpret_cast< const uint8_t* >( &val ) };
+      code.insert( code.end(), p, p + sizeof( T ) );
+    }
+
+    Batch& record( Op op, Identity a, Identity b = CoreAGI::NIHIL ){
+      emit( uint8_t( op ) );
+      emit( a );
+      if( op != CREATE and op != FORGET ) emit( b );
+      count++;
+      return *this;
+    }
+
+    static bool decode( std::span< const uint8_t > code, std::function< bool( const Record& ) > f ){
+                                                                                                                              /*
+      Call `f` for each encoded operation; returns `false` if code is malformed or `f` returns `false`:
+                                                                                                                              */
+      const uint8_t* p  { code.data()       };
+      const uint8_t* end{ p + code.size()   };
+      auto get = [&]( void* val, size_t size )->bool{
+        if( p + size > end ) return false;
+        memcpy( val, p, size );
+        p += size;
+        return true;
+      };
+      Record R{};
+      while( p < end ){
+        uint8_t op;
+        if( not get( &op, 1 ) ) return false;
+        R.op = Op( op );
+        R.list.clear();
+        if( not get( &R.a, sizeof( Identity ) ) ) return false;
+        switch( R.op ){
+          case CREATE:
+            break;
+          case FORGET:
+            if( not get( &R.flag, 1 ) ) return false;
+            break;
+          case SEQ: {
+            uint32_t n;
+            if( not get( &n, sizeof( n ) ) or p + size_t( n )*sizeof( Identity ) > end ) return false;
+            R.list.resize( n );
+            get( R.list.data(), n*sizeof( Identity ) );
+            break;
+          }
+          case INCL: case EXCL: case ABSORB: case DROP:
+            if( not get( &R.b, sizeof( Identity ) ) ) return false;
+            break;
+          case PUT: // :packed cargo, string rebuilt (interned) from its chars
+            if( not get( &R.b, sizeof( Identity ) ) or not Data::Cargo::unpack( p, end, R.cargo ) ) return false;
+            break;
+          default:
+            return false;
+        }
+        if( not f( R ) ) return false;
+      }
+      return true;
+    }
+
+    static bool check( const Gnosis& G, const Data::Storage* data, std::span< const uint8_t > code, std::string& error ){
+                                                                                                                              /*
+      Check that all operations can be applied to the current state of the graph. Besides
+      existence of the referred entities, capacity is reserved (free cells of the segments for
+      created entities, upper bound of the syndrome size with heritable signs for included ones)
+      and IMMORTAL / IMMUTABLE restrictions of `forget` and `absorb` checked, so checked batch
+      can`t fail at `apply(..)` when it is already in the journal:
+                                                                                                                              */
+      std::set< Identity > born; // :created by the batch
+      std::set< Identity > gone; // :forgotten or absorbed by the batch
+      auto alive = [&]( Identity id )->bool{
+        if( id == CoreAGI::NIHIL or gone.contains( id ) ) return false;
+        return born.contains( id ) or G.exists( id );
+      };
+      std::map< Identity, std::vector< Identity > > added;   // :signs the batch may add into syndrome
+      std::map< Identity, std::vector< Identity > > holders; // :entities the batch adds the sign to
+      std::map< std::pair< Identity, Identity >, bool > flag; // :IMMORTAL/IMMUTABLE/HERITABLE changed by batch
+      unsigned fresh[ NUMBER_OF_SEGMENTS ]{};                // :entities created in the segment
+      auto signs = [&]( Identity id )->std::vector< Identity >{
+        std::vector< Identity > L;
+        if( const Signs* Y{ born.contains( id ) ? nullptr : G.S_( id ) }; Y ) for( const auto s: *Y ) L.push_back( s );
+        if( const auto it{ added.find( id ) }; it != added.end() ) L.insert( L.end(), it->second.begin(), it->second.end() );
+        return L;
+      };
+      auto is = [&]( Identity id, const Entity& sign )->bool{
+        if( const auto it{ flag.find( { id, sign.id } ) }; it != flag.end() ) return it->second;
+        const Signs* Y{ born.contains( id ) ? nullptr : G.S_( id ) };
+        return Y and Y->contains( sign.id );
+      };
+      auto add = [&]( Identity id, Identity sign ){
+                                                                                                                              /*
+        Sign with its heritable signs (see `Entity.incl(..)`):
+                                                                                                                              */
+        std::vector< Identity > L{ sign };
+        for( const auto t: signs( sign ) ) if( is( t, G.HERITABLE ) ) L.push_back( t );
+        for( const auto t: L ){
+          added  [ id ].push_back( t );
+          holders[ t  ].push_back( id );
+          if( t == G.IMMORTAL.id or t == G.IMMUTABLE.id or t == G.HERITABLE.id ) flag[ { id, t } ] = true;
+        }
+      };
+      unsigned n{ 0 };
+      const bool ok = decode( code, [&]( const Record& R )->bool{
+        n++;
+        switch( R.op ){
+          case CREATE:
+            if( R.a == CoreAGI::NIHIL or R.a >= Flat::UINT24 or alive( R.a ) ){
+              error = kit( "operation %u: entity %u can`t be created", n, R.a );
+              return false;
+            }
+            if( G.segment( R.a ).size() + ++fresh[ R.a % NUMBER_OF_SEGMENTS ] > Shard::capacity() ){
+              error = kit( "operation %u: segment capacity exhausted", n );
+              return false;
+            }
+            born.insert( R.a );
+            gone.erase ( R.a );
+            return true;
+          case INCL:
+            if( not alive( R.a ) or not alive( R.b ) ) break;
+            add( R.a, R.b );
+            return true;
+          case EXCL:
+            if( not alive( R.a ) or not alive( R.b ) ) break;
+            flag[ { R.a, R.b } ] = false;
+            return true;
+          case SEQ:
+            if( not alive( R.a ) ) break;
+            for( const auto id: R.list ) if( not alive( id ) ){ error = kit( "operation %u: alien element %u", n, id ); return false; }
+            return true;
+          case FORGET:
+            if( not alive( R.a ) ) break;
+            if( is( R.a, G.IMMORTAL ) ){ error = kit( "operation %u: entity %u is immortal", n, R.a ); return false; }
+            gone.insert( R.a );
+            return true;
+          case ABSORB: {
+            if( not alive( R.a ) or not alive( R.b ) or R.a == R.b ) break;
+                                                                                                                              /*
+            See `Entity.absorb(..)`: syndrome of `b` moves to `a`, children of `b` get `a`:
+                                                                                                                              */
+            std::vector< Identity > children{ holders[ R.b ] };
+            if( not born.contains( R.b ) ) for( const auto& c: G.recover( R.b ).E() ) children.push_back( c.id );
+            bool immutable{ is( R.a, G.IMMUTABLE ) };
+            for( const auto c: children ) immutable = immutable or ( alive( c ) and is( c, G.IMMUTABLE ) );
+            if( is( R.b, G.IMMORTAL ) or immutable ){
+              error = kit( "operation %u: entity %u can`t absorb %u", n, R.a, R.b );
+              return false;
+            }
+            for( const auto t: signs( R.b ) ) add( R.a, t );
+            for( const auto c: children ) if( alive( c ) ) add( c, R.a );
+            gone.insert( R.b );
+            return true;
+          }
+          case PUT: case DROP:
+            if( not data ){ error = kit( "operation %u: no data storage", n ); return false; }
+            if( alive( R.a ) and alive( R.b ) ) return true;
+            break;
+          default:
+            break;
+        }
+        error = kit( "operation %u: alien entity", n );
+        return false;
+      });
+      if( not ok and error.empty() ) error = kit( "operation %u: malformed code", n );
+      if( not ok ) return false;
+                                                                                                                              /*
+      Upper bound of the syndrome size (repeated signs counted each time):
+                                                                                                                              */
+      for( const auto& [ id, L ]: added ){
+        if( not alive( id ) ) continue;
+        const Signs* Y{ born.contains( id ) ? nullptr : G.S_( id ) };
+        if( ( Y ? Y->size() : 0 ) + L.size() > CAPACITY_OF_SYNDROME ){
+          error = kit( "syndrome of entity %u may exceed capacity", id );
+          return false;
+        }
+      }
+      return true;
+    }
+
+    static bool apply( Gnosis& G, Data::Storage* data, std::span< const uint8_t > code ){
+                                                                                                                              /*
+      Apply checked operations using regular Entity methods, so all side effects
+      (heritable and mutually exclusive signs, ID change processors) take place;
+      operations of the checked batch can`t fail, so `false` means broken check:
+                                                                                                                              */
+      return decode( code, [&]( const Record& R )->bool{
+        bool done{ true };
+        if( R.op == CREATE ){
+          Entity( G.ID, R.a );
+          done = G.exists( R.a );
+        } else {
+          Entity e{ G.recover( R.a ) };
+          switch( R.op ){
+            case INCL  : { const Entity s{ G.recover( R.b ) }; done = e.incl( s ).is( s ); } break;
+            case EXCL  : e.excl  ( G.recover( R.b ) ); break;
+            case FORGET: done = e.forget( R.flag ); break;
+            case ABSORB: { Entity x{ G.recover( R.b ) }; done = e.absorb( x ); } break;
+            case PUT   : data->put ( data->key( R.a, R.b ), R.cargo ); break;
+            case DROP  : data->excl( data->key( R.a, R.b )          ); break;
+            case SEQ   : {
+              Sequence Q{ G.sequence() };
+              for( const auto id: R.list ) Q += G.recover( id );
+              e.seq( Q );
+              break;
+            }
+            default: assert( false );
+          }
+        }
+        return done;
+      });
+    }
+
+  public:
+
+    enum Outcome: uint8_t {
+      REJECTED  = 0, // :check failed, nothing changed (see `error()`)
+      COMMITTED = 1, // :applied and journaled according to the synchronization policy
+      UNSYNCED  = 2  // :applied, but journal failed to write the frame (see `error()`)
+    };
+
+    Batch( Gnosis& gnosis, Data::Storage* data = nullptr, Journal* journal = nullptr ):
+      Local   { gnosis.ID },
+      data    { data      },
+      journal { journal   },
+      code    {           },
+      reserved{           },
+      count   { 0         },
+      ERROR   {           }
+    {}
+
+    Batch( const Batch& ) = delete;
+    Batch& operator = ( const Batch& ) = delete;
+
+    size_t size () const { return count;      }
+    bool   empty() const { return count == 0; }
+
+    const std::string& error() const { return ERROR; }
+
+    void clear(){
+      code.clear();
+      reserved.clear();
+      count = 0;
+    }
+
+    Entity entity(){
+                                                                                                                              /*
+      Reserve random ID for new entity; entity will be created at commit:
+                                                                                                                              */
+      const Gnosis& G{ gnosis() };
+      Entity e{ unit }; // :private constructor
+      for( unsigned maxDistance = 0; maxDistance <= 6; maxDistance++ ){
+        for( unsigned attempt = 0; attempt < 32; attempt++ ){
+          const Identity id{ Identity( randomNumber() & 0xFFFFFF ) };
+          if( id == CoreAGI::NIHIL or reserved.contains( id ) or G.exists( id ) ) continue;
+          if( not G.segment( id ).vacant( id, maxDistance ) ) continue;
+          reserved.insert( id );
+          record( CREATE, id );
+          e.id = id;
+          return e;
+        }
+      }
+      return e; // :NIHIL, capacity exhausted
+    }
+
+    Entity entity( std::initializer_list< Entity > syndrome ){
+      Entity e{ entity() };
+      if( bool( e ) ) for( const auto& sign: syndrome ) incl( e, sign );
+      return e;
+    }
+
+    Batch& incl  ( const Entity& e, const Entity& sign ){ assert( mate( e ) and mate( sign ) ); return record( INCL,   e.id, sign.id ); }
+    Batch& excl  ( const Entity& e, const Entity& sign ){ assert( mate( e ) and mate( sign ) ); return record( EXCL,   e.id, sign.id ); }
+    Batch& absorb( const Entity& e, const Entity& x    ){ assert( mate( e ) and mate( x    ) ); return record( ABSORB, e.id, x.id    ); }
+
+    Batch& forget( const Entity& e, bool skipCheck = false ){
+      assert( mate( e ) );
+      record( FORGET, e.id );
+      emit( uint8_t( skipCheck ) );
+      return *this;
+    }
+
+    Batch& seq( const Entity& e, std::initializer_list< Entity > sequence ){
+      assert( mate( e ) );
+      emit( uint8_t( SEQ ) );
+      emit( e.id );
+      emit( uint32_t( sequence.size() ) );
+      for( const auto& elem: sequence ){ assert( mate( elem ) ); emit( elem.id ); }
+      count++;
+      return *this;
+    }
+
+    Batch& seq( const Entity& e, const Sequence& sequence ){
+      assert( mate( e ) and mate( sequence ) );
+      emit( uint8_t( SEQ ) );
+      emit( e.id );
+      emit( uint32_t( sequence.size() ) );
+      for( unsigned i = 0; i < sequence.size(); i++ ) emit( sequence[i].id );
+      count++;
+      return *this;
+    }
+
+    Batch& put( const Entity& obj, const Entity& atr, const Data::Cargo& val ){
+      assert( mate( obj ) and mate( atr ) );
+      record( PUT, obj.id, atr.id );
+      Data::Cargo::pack( code, val ); // :handle of interned string is local for process
+      return *this;
+    }
+
+    Batch& drop( const Entity& obj, const Entity& atr ){
+      assert( mate( obj ) and mate( atr ) );
+      return record( DROP, obj.id, atr.id );
+    }
+
+    Outcome commit(){
+                                                                                                                              /*
+      Check, apply and journal all recorded operations; batch is cleared anyway:
+                                                                                                                              */
+      ERROR.clear();
+      if( empty() ) return COMMITTED;
+      Gnosis&  G  { gnosis() };
+      uint64_t lsn{ 0        };
+      {
+        std::lock_guard< std::mutex > lock( G.commitMutex );
+        if( journal and not journal->live() ){ ERROR = "journal is not opened or failed"; clear(); return REJECTED; }
+        if( not check( G, data, code, ERROR ) ){ clear(); return REJECTED; }
+        [[maybe_unused]] const bool applied{ apply( G, data, code ) };
+        assert( applied ); // :see `check(..)`
+        if( journal ) lsn = journal->append( code );
+      }
+      clear();
+      if( journal and not journal->sync( lsn ) ){
+        ERROR = kit( "journal failure: %s", journal->error().c_str() );
+        return UNSYNCED;
+      }
+      return COMMITTED;
+    }
+
+    static size_t replay( const char* path, Gnosis& G, Data::Storage* data = nullptr, std::string* error = nullptr,
+                          uint64_t after = 0 ){
+                                                                                                                              /*
+      Apply batches stored in the journal; stops at first batch that can`t be applied.
+      Over restored checkpoint only batches after its fence applied (`after` = `G.checkpointFence()`):
+                                                                                                                              */
+      std::lock_guard< std::mutex > lock( G.commitMutex );
+      return Journal::replay(
+        path,
+        [&]( uint64_t lsn, std::span< const uint8_t > code )->bool{
+          std::string E;
+          if( not check( G, data, code, E ) ){
+            if( error ) *error = kit( "frame %lu: %s", lsn, E.c_str() );
+            return false;
+          }
+          [[maybe_unused]] const bool applied{ apply( G, data, code ) };
+          assert( applied ); // :see `check(..)`
+          return true;
+        },
+        error,
+        after
+      );
+    }
+
+  };//class Gnosis::Batch
+
+}//namespace CoreAGI
+
+#endif // BATCH_H_INCLUDED
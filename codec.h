@@ -7,6 +7,11 @@
  Utility for base64-like encoding and decoding sequence of Identities
 
  2020.07.28
+
+ 2026.10.19 Added varint (LEB128) encoding used by binary image of the Gnosis
+ 2026.10.19 Added block-buffered `EncodedReader` and `EncodedWriter` for text files
+            with vectorized classification of separators
+ 2026.10.19 Varint encoding generalized to 64-bit numbers
 ________________________________________________________________________________________________________________________________
                                                                                                                               */
 #ifndef CODEC_H_INCLUDED
@@ -19,6 +24,16 @@ ________________________________________________________________________________
 #include <string>
 #include <functional>
 #include <type_traits>
+#include <vector>                                                                                              // [+] 2026.10.19
+#include <bit>              // :countr_zero                                                                    // [+] 2026.10.19
+#include <cstring>          // :memchr                                                                         // [+] 2026.10.19
+#include <span>                                                                                                // [+] 2026.10.19
+#include <string_view>                                                                                         // [+] 2026.10.19
+#include <concepts>         // :unsigned_integral                                                              // [+] 2026.10.19
+
+#ifdef __SSE2__
+  #include <emmintrin.h>                                                                                       // [+] 2026.10.19
+#endif
 
 #include "def.h"  // :Identity definition
 
@@ -103,6 +118,10 @@ namespace CoreAGI {
 
   public:
                                                                                                                               /*
+    Value of the symbol; 255 for symbols that are not used in encoding:
+                                                                                                                              */
+    static uint8_t digit( char c ){ return M[ uint8_t( c ) ]; }                                                // [+] 2026.10.19
+                                                                                                                              /*
     Encoding:
                                                                                                                               */
     static constexpr const char SYMBOL[ BASE+1 ]{ "0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ@$" };
@@ -225,6 +244,224 @@ namespace CoreAGI {
     return ID;
   }
 
+                                                                                                                              /*
+  Block-buffered text codec: lines of encoded ID separated by spaces (see `Encoded`).
+
+  Separators classified 16 bytes at once (any byte <= ' ' is a separator), so each
+  token or run of separators costs a single vector operation; symbols of the token
+  decoded by the table of `Encoded` and checked all together at the end of token:
+                                                                                                                              */
+  inline unsigned separators( const char* p ){                                                                 // [+] 2026.10.19
+                                                                                                                              /*
+    Bit mask of separators among 16 bytes starting at `p` (bit `i` refers `p[i]`):
+                                                                                                                              */
+#ifdef __SSE2__
+    const __m128i x    { _mm_loadu_si128( reinterpret_cast< const __m128i* >( p ) ) };
+    const __m128i SPACE{ _mm_set1_epi8( ' ' )                                        };
+    return unsigned( _mm_movemask_epi8( _mm_cmpeq_epi8( _mm_max_epu8( x, SPACE ), SPACE ) ) );
+#else
+    unsigned mask{ 0 };
+    for( unsigned i = 0; i < 16; i++ ) mask |= unsigned( uint8_t( p[i] ) <= ' ' ) << i;
+    return mask;
+#endif
+  }
+
+  class EncodedReader {                                                                                        // [+] 2026.10.19
+                                                                                                                              /*
+    Reads file by large blocks and splits it into lines; replaces `Encoded( FILE* )` that
+    reads file symbol by symbol:
+                                                                                                                              */
+    static constexpr size_t BLOCK{ 1 << 20 };
+    static constexpr size_t SLACK{ 16      }; // :vector loads never cross end of the buffer
+
+    FILE*               src;
+    std::vector< char > buffer;
+    size_t              head;    // :begin of unprocessed data
+    size_t              tail;    // :end of data read
+    bool                eof;
+    bool                broken;  // :malformed data found
+
+    bool fill(){
+                                                                                                                              /*
+      Move unprocessed data to the begin of the buffer and read next block; grow buffer
+      if it is filled by single line:
+                                                                                                                              */
+      if( eof ) return false;
+      memmove( buffer.data(), buffer.data() + head, tail - head );
+      tail -= head;
+      head  = 0;
+      if( buffer.size() - SLACK - tail < BLOCK/2 ) buffer.resize( 2*buffer.size() );
+      const size_t n{ fread( buffer.data() + tail, 1, buffer.size() - SLACK - tail, src ) };
+      tail += n;
+      if( n == 0 ) eof = true;
+      return n > 0;
+    }
+
+  public:
+
+    explicit EncodedReader( FILE* src ): src{ src }, buffer( BLOCK + SLACK ), head{ 0 }, tail{ 0 }, eof{ false }, broken{ false }{
+      assert( src );
+    }
+
+    bool good() const { return not broken; }
+
+    bool line( std::string_view& text ){
+                                                                                                                              /*
+      Next line without line feed; returns `false` at end of file. View valid until next call:
+                                                                                                                              */
+      for(;;){
+        const char* begin{ buffer.data() + head };
+        const char* lf{ static_cast< const char* >( memchr( begin, '\n', tail - head ) ) };
+        if( lf ){
+          text  = std::string_view( begin, lf - begin );
+          head += lf - begin + 1;
+          return true;
+        }
+        if( not fill() ){ // Last line may have no line feed:
+          if( head == tail ) return false;
+          text = std::string_view( buffer.data() + head, tail - head );
+          head = tail;
+          return true;
+        }
+      }
+    }
+
+    bool line( std::vector< Identity >& ids ){
+                                                                                                                              /*
+      Decode next non-empty line of encoded ID into `ids`; returns `false` at end of file
+      or if line is malformed (see `good()`):
+                                                                                                                              */
+      std::string_view text;
+      for(;;){
+        if( not line( text ) ) return false;
+        ids.clear();
+        if( not decode( text, ids ) ){ broken = true; return false; }
+        if( not ids.empty() ) return true;
+      }
+    }
+
+    static bool decode( std::string_view text, std::vector< Identity >& ids ){
+                                                                                                                              /*
+      Append decoded ID of the `text` to `ids`; `text` has to be followed by at least 16 bytes
+      of accessible memory (true for lines returned by `line(..)`):
+                                                                                                                              */
+      const char* p  { text.data()       };
+      const char* end{ p + text.size()   };
+      while( p < end ){
+        const size_t rest{ size_t( end - p ) };
+        unsigned mask{ separators( p ) };
+        if( rest < 16 ) mask |= 0xFFFFu << rest; // :bytes after the line treated as separators
+        if( mask & 1 ){ // Skip separators:
+          const unsigned n( std::countr_one( mask & 0xFFFF ) );
+          p += n;
+          continue;
+        }
+        const unsigned length( std::countr_zero( mask | 0x10000 ) );
+        if( length > 4 ) return false; // :ID is 24 bits, i.e. four symbols at most
+        uint32_t u{ 0 };
+        uint8_t  bad{ 0 };
+        for( unsigned i = 0; i < length; i++ ){
+          const uint8_t d{ Encoded< Identity >::digit( p[i] ) };
+          bad |= d;
+          u    = u*64 + d;
+        }
+        if( bad >= 64 ) return false;
+        ids.push_back( Identity( u ) );
+        p += length;
+      }
+      return true;
+    }
+
+  };//class EncodedReader
+
+  class EncodedWriter {                                                                                        // [+] 2026.10.19
+                                                                                                                              /*
+    Collects text in large buffer that written by single `fwrite`; replaces `fprintf` per ID:
+                                                                                                                              */
+    static constexpr size_t BLOCK  { 1 << 20 };
+    static constexpr size_t RESERVE{ 64      }; // :room for a few encoded numbers without check
+
+    FILE*               out;
+    std::vector< char > buffer;
+    size_t              size;
+    bool                ok;
+
+  public:
+
+    explicit EncodedWriter( FILE* out ): out{ out }, buffer( BLOCK ), size{ 0 }, ok{ true }{ assert( out ); }
+
+   ~EncodedWriter(){ flush(); }
+
+    EncodedWriter( const EncodedWriter& ) = delete;
+    EncodedWriter& operator = ( const EncodedWriter& ) = delete;
+
+    bool flush(){
+      if( size > 0 ) ok = ( fwrite( buffer.data(), 1, size, out ) == size ) and ok;
+      size = 0;
+      return ok;
+    }
+
+    void put( Identity id ){
+      if( size + RESERVE > buffer.size() ) flush();
+      char  text[ 8 ];
+      char* head{ text + 8 };
+      do { *( --head ) = Encoded< Identity >::SYMBOL[ id & 63 ]; id >>= 6; } while( id );
+      const size_t n( text + 8 - head );
+      memcpy( buffer.data() + size, head, n );
+      size += n;
+    }
+
+    void put( char c ){
+      if( size + RESERVE > buffer.size() ) flush();
+      buffer[ size++ ] = c;
+    }
+
+    void put( std::string_view text ){
+      if( size + text.size() + RESERVE > buffer.size() ) flush();
+      if( text.size() + RESERVE > buffer.size() ){ ok = ( fwrite( text.data(), 1, text.size(), out ) == text.size() ) and ok; return; }
+      memcpy( buffer.data() + size, text.data(), text.size() );
+      size += text.size();
+    }
+
+    void line( std::span< const Identity > ids ){
+                                                                                                                              /*
+      Write ID separated by single space and followed by line feed:
+                                                                                                                              */
+      for( size_t i = 0; i < ids.size(); i++ ){
+        if( i > 0 ) put( ' ' );
+        put( ids[i] );
+      }
+      put( '\n' );
+    }
+
+  };//class EncodedWriter
+
+                                                                                                                              /*
+  Variable-length (LEB128) encoding of unsigned integers: 7 bits per byte, high bit
+  marks continuation; small numbers (in particular deltas of sorted ID) take 1..2 bytes:
+                                                                                                                              */
+  template< std::unsigned_integral U > inline void putVarint( std::vector< uint8_t >& out, U u ){             // [m] 2026.10.19
+    while( u >= 0x80 ){
+      out.push_back( uint8_t( u | 0x80 ) );
+      u >>= 7;
+    }
+    out.push_back( uint8_t( u ) );
+  }
+
+  template< std::unsigned_integral U > inline bool getVarint( const uint8_t*& p, const uint8_t* end, U& u ){  // [m] 2026.10.19
+                                                                                                                              /*
+    Decode number starting at `p` and advance `p`; returns `false` if data truncated or malformed:
+                                                                                                                              */
+    u = 0;
+    for( unsigned shift = 0; shift < 8*sizeof( U ) + 7; shift += 7 ){
+      if( p >= end ) return false;
+      const uint8_t b{ *p++ };
+      u |= U( b & 0x7F ) << shift;
+      if( not ( b & 0x80 ) ) return true;
+    }
+    return false;
+  }
+
 }//CoreAGI
 
 #endif // CODEC_H_INCLUDED
@@ -0,0 +1,2 @@
+g++-10 -Wall -fexceptions -std=c++20 -m64 -c test.cpp -o test.o
+g++-10 -o test test.o -s -m64 -lpthread
@@ -23,6 +23,14 @@
 
   2021/02.20  Definitions of Identity, Key etc moved to `def.h`
 
+  2026.10.19  Config::journal added; Config::gnosis::IMAGE added;
+              Config::gnosis::CHECKPOINT and Config::gnosis::CHECKPOINT_DELTAS added;
+              Config::gnosis::CHECKPOINT_BANDWIDTH added; Config::hmi::STORAGE added;
+              Config::data::IMAGE added; Config::glossary::CAPACITY_OF_CACHE added;
+              Config::glossary::COMPLETION_LIMIT added;
+              Config::glossary::SIMILARITY_DISTANCE and Config::glossary::SIMILARITY_LIMIT added;
+              Config::glossary::IMAGE added
+
 ________________________________________________________________________________________________________________________________
                                                                                                                               */
 #ifndef CONFIG_H_INCLUDED
@@ -73,6 +81,10 @@ namespace CoreAGI {
       }
     }
 
+    namespace hmi {                                                                                            // [+] 2026.10.19
+      constexpr const char* STORAGE { "storage" }; // :default folder of checkpoints written by `#W` command
+    }
+
     namespace postfix {
       constexpr unsigned STACK_CAPACITY { 4096 };
     }
@@ -81,6 +93,8 @@ namespace CoreAGI {
 
       constexpr unsigned CACHE_RESERVATION_FACTOR { 3 }; //
 
+      constexpr const char* IMAGE { "data.img" }; // :binary image of the data storage, next to the Gnosis image // [+] 2026.10.19
+
       namespace fast {
         constexpr size_t      SPACE         { 256*1024 }; // :memory pool size, bytes
         constexpr size_t      CAPACITY      {    32803 }; // :max number of stored items      (prime number preferred)
@@ -102,7 +116,7 @@ namespace CoreAGI {
 
       constexpr unsigned ARENA_CAPACITY       {  256*1024   }; // :Bites
 
-      constexpr unsigned NUMBER_OF_THREADS    {         3   }; // :in the analogic                                [+] 2021.01.02
+      constexpr unsigned NUMBER_OF_THREADS    {         3   }; // :in the analogic if hardware concurrency unknown [m] 2026.10.19
       constexpr unsigned NO_JOB_PAUSE         {        50   }; // :pause at `no request` situation, millisec   // [+] 2021.06.08
 
       constexpr unsigned NUMBER_OF_SEGMENTS   {         8   }; // :number of graph`s segments                  // [+] 2020.07.11
@@ -117,9 +131,14 @@ namespace CoreAGI {
 //    constexpr unsigned CAPACITY_OF_PATH     {       256   }; // :maximal expected number of entity signs     // [+] 2020.07.24
 
       constexpr unsigned CAPACITY_OF_ANALOGY  {        16   }; // :max size of graph pattern                   // [+] 2021.06.14
+      constexpr bool     ANALOGIC_JOIN        {      true   }; // :analogic intersects lists of all neighbours  // [+] 2026.10.19
 
       constexpr const char* SYNDROMES         { "syndromes" }; // :syndromes file                              // [+] 2020.07.24
       constexpr const char* SEQUENCES         { "sequences" }; // :sequences file                              // [+] 2020.07.24
+      constexpr const char* IMAGE             { "gnosis.img" }; // :binary image file                          // [+] 2026.10.19
+      constexpr const char* CHECKPOINT        { "checkpoint" }; // :manifest of incremental checkpoints         // [+] 2026.10.19
+      constexpr unsigned    CHECKPOINT_DELTAS {         16   }; // :deltas before compaction into new base
+      constexpr unsigned    CHECKPOINT_BANDWIDTH{       64   }; // :MB/sec of background checkpoint, 0 - unlimited
 
     }
 
@@ -138,9 +157,19 @@ namespace CoreAGI {
       constexpr unsigned STR_CAPACITY { 64*1024 }; // :capacity of string storage
     }
 
+    namespace journal {                                                                                        // [+] 2026.10.19
+      constexpr const char* JOURNAL              {  "journal" }; // :write-ahead log file
+      constexpr unsigned    SYNC_INTERVAL        {        100 }; // :fsync interval for `INTERVAL` policy, millisec
+    }
+
     namespace glossary {
       constexpr const char* GLOSSARY             { "glossary" }; // :glossary file                             // [+] 2020.07.24
+      constexpr const char* IMAGE            { "glossary.img" }; // :binary image of the glossary              // [+] 2026.10.19
       constexpr unsigned    CAPACITY_OF_LEX      {       1024 }; // :max length of entity name                 // [+] 2020.07.24
+      constexpr unsigned    CAPACITY_OF_CACHE    {  64*1024   }; // :max number of cached renderings           // [+] 2026.10.19
+      constexpr unsigned    COMPLETION_LIMIT     {         16 }; // :max number of names offered by completion // [+] 2026.10.19
+      constexpr unsigned    SIMILARITY_DISTANCE  {          2 }; // :max edit distance of suggested name       // [+] 2026.10.19
+      constexpr unsigned    SIMILARITY_LIMIT     {          5 }; // :max number of suggested names             // [+] 2026.10.19
     }
 
     namespace sequel {
@@ -0,0 +1,45 @@
+                                                                                                                              /*
+ Copyright Mykola Rabchevskiy 2021.
+ Distributed under the Boost Software License, Version 1.0.
+ (See http://www.boost.org/LICENSE_1_0.txt)
+ ______________________________________________________________________________
+
+ CRC-32 (IEEE 802.3, reflected polynomial 0xEDB88320) used for integrity check
+ of the binary files (journal, snapshot)
+
+ 2026.10.19
+________________________________________________________________________________________________________________________________
+                                                                                                                              */
+#ifndef CRC_H_INCLUDED
+#define CRC_H_INCLUDED
+
+#include <cstddef>
+#include <cstdint>
+
+#include <array>
+
+namespace CoreAGI {
+
+  constexpr std::array< uint32_t, 256 > CRC32_TABLE = [](){
+    std::array< uint32_t, 256 > T{};
+    for( uint32_t i = 0; i < 256; i++ ){
+      uint32_t c{ i };
+      for( int k = 0; k < 8; k++ ) c = ( c & 1 ) ? 0xEDB88320u ^ ( c >> 1 ) : c >> 1;
+      T[i] = c;
+    }
+    return T;
+  }();
+
+  inline uint32_t crc32( const void* data, size_t size, uint32_t crc = 0 ){
+                                                                                                                              /*
+    Returns CRC of the `data`; previous value of the `crc` allows to process data by parts:
+                                                                                                                              */
+    const uint8_t* p{ static_cast< const uint8_t* >( data ) };
+    crc = ~crc;
+    for( size_t i = 0; i < size; i++ ) crc = CRC32_TABLE[ ( crc ^ p[i] ) & 0xFF ] ^ ( crc >> 8 );
+    return ~crc;
+  }
+
+}//namespace CoreAGI
+
+#endif // CRC_H_INCLUDED
@@ -0,0 +1,216 @@
+                                                                                                                              /*
+ Copyright Mykola Rabchevskiy 2021.
+ Distributed under the Boost Software License, Version 1.0.
+ (See http://www.boost.org/LICENSE_1_0.txt)
+ ______________________________________________________________________________
+
+  Column - dense storage of the numeric values of single attribute: object IDs
+  and values kept in two parallel arrays sorted by object ID, so aggregates over
+  the attribute scan contiguous memory instead of one hash lookup per object.
+
+  Changes accumulated in the pending list and merged into the arrays before
+  reading, so `put` and `excl` cost O(1); the last change of the object wins.
+
+  Aggregates (count, sum, min, max, histogram) computed by SSE2 kernels with
+  scalar fallback, over all values or over sorted subset of objects (e.g.
+  entities that have particular syndrome).
+
+  2026.10.19 Initial version
+________________________________________________________________________________________________________________________________
+                                                                                                                              */
+#ifndef DATA_COLUMN_H_INCLUDED
+#define DATA_COLUMN_H_INCLUDED
+
+#include <cmath>
+#include <cstdint>
+
+#include <algorithm>
+#include <limits>
+#include <span>
+#include <vector>
+
+#ifdef __SSE2__
+  #include <emmintrin.h>
+#endif
+
+#include "def.h"
+
+namespace CoreAGI::Data {
+
+  template< typename T > struct Summary {
+    size_t count{ 0                                  };
+    T      sum  { 0                                  };
+    T      min  { std::numeric_limits< T >::max()    };
+    T      max  { std::numeric_limits< T >::lowest() };
+
+    double mean() const { return count ? double( sum )/double( count ) : std::nan( "" ); }
+  };
+
+  namespace Kernel {
+                                                                                                                              /*
+    Reductions over contiguous values; four independent accumulators (two SSE2 registers
+    for doubles) hide latency of the additions and comparisons:
+                                                                                                                              */
+    inline Summary< double > summary( std::span< const double > v ){
+      Summary< double > S;
+      S.count = v.size();
+      size_t i{ 0 };
+#ifdef __SSE2__
+      __m128d sum0{ _mm_setzero_pd() }, sum1{ _mm_setzero_pd() };
+      __m128d min0{ _mm_set1_pd( S.min ) }, min1{ min0 };
+      __m128d max0{ _mm_set1_pd( S.max ) }, max1{ max0 };
+      for( ; i + 4 <= v.size(); i += 4 ){
+        const __m128d a{ _mm_loadu_pd( v.data() + i     ) };
+        const __m128d b{ _mm_loadu_pd( v.data() + i + 2 ) };
+        sum0 = _mm_add_pd( sum0, a ); sum1 = _mm_add_pd( sum1, b );
+        min0 = _mm_min_pd( min0, a ); min1 = _mm_min_pd( min1, b );
+        max0 = _mm_max_pd( max0, a ); max1 = _mm_max_pd( max1, b );
+      }
+      double s[ 2 ], lo[ 2 ], hi[ 2 ];
+      _mm_storeu_pd( s,  _mm_add_pd( sum0, sum1 ) );
+      _mm_storeu_pd( lo, _mm_min_pd( min0, min1 ) );
+      _mm_storeu_pd( hi, _mm_max_pd( max0, max1 ) );
+      S.sum = s[0] + s[1];
+      S.min = std::min( lo[0], lo[1] );
+      S.max = std::max( hi[0], hi[1] );
+#endif
+      for( ; i < v.size(); i++ ){
+        S.sum += v[i];
+        S.min  = std::min( S.min, v[i] );
+        S.max  = std::max( S.max, v[i] );
+      }
+      return S;
+    }
+
+    inline Summary< int64_t > summary( std::span< const int64_t > v ){
+      Summary< int64_t > S;
+      S.count = v.size();
+      int64_t sum[ 4 ]{ 0, 0, 0, 0 };
+      int64_t lo [ 4 ]{ S.min, S.min, S.min, S.min };
+      int64_t hi [ 4 ]{ S.max, S.max, S.max, S.max };
+      size_t  i{ 0 };
+      for( ; i + 4 <= v.size(); i += 4 ){
+        for( unsigned k = 0; k < 4; k++ ){
+          sum[k] += v[ i + k ];
+          lo [k]  = std::min( lo[k], v[ i + k ] );
+          hi [k]  = std::max( hi[k], v[ i + k ] );
+        }
+      }
+      for( ; i < v.size(); i++ ){
+        sum[0] += v[i];
+        lo [0]  = std::min( lo[0], v[i] );
+        hi [0]  = std::max( hi[0], v[i] );
+      }
+      S.sum = sum[0] + sum[1] + sum[2] + sum[3];
+      S.min = std::min( std::min( lo[0], lo[1] ), std::min( lo[2], lo[3] ) );
+      S.max = std::max( std::max( hi[0], hi[1] ), std::max( hi[2], hi[3] ) );
+      return S;
+    }
+
+    template< typename T > void histogram( std::span< const T > v, T lo, T hi, std::span< size_t > bins ){
+                                                                                                                              /*
+      Add values into equal bins over [lo, hi); values out of range ignored:
+                                                                                                                              */
+      if( bins.empty() or not ( lo < hi ) ) return;
+      const double scale{ double( bins.size() )/( double( hi ) - double( lo ) ) };
+      for( const T x: v ){
+        if( x < lo or not ( x < hi ) ) continue;
+        const size_t b{ size_t( ( double( x ) - double( lo ) )*scale ) };
+        bins[ std::min( b, bins.size() - 1 ) ]++;
+      }
+    }
+
+  }//namespace Kernel
+
+  template< typename T > class Column {
+
+    struct Change {
+      Identity obj;
+      bool     erased;
+      T        val;
+    };
+
+    std::vector< Identity > object;  // :sorted
+    std::vector< T        > value;   // :parallel to `object`
+    std::vector< Change   > pending; // :changes after the last merge
+
+    void merge(){
+                                                                                                                              /*
+      Apply pending changes: sort them by object keeping order of the changes of the same
+      object, then merge with the arrays in single pass:
+                                                                                                                              */
+      if( pending.empty() ) return;
+      std::stable_sort( pending.begin(), pending.end(), []( const Change& a, const Change& b ){ return a.obj < b.obj; } );
+      std::vector< Identity > O;
+      std::vector< T        > V;
+      O.reserve( object.size() + pending.size() );
+      V.reserve( object.size() + pending.size() );
+      size_t i{ 0 };
+      for( size_t k = 0; k < pending.size(); k++ ){
+        if( k + 1 < pending.size() and pending[ k + 1 ].obj == pending[k].obj ) continue; // :not the last change
+        const Change& C{ pending[k] };
+        for( ; i < object.size() and object[i] < C.obj; i++ ){ O.push_back( object[i] ); V.push_back( value[i] ); }
+        if( i < object.size() and object[i] == C.obj ) i++; // :replaced or erased
+        if( not C.erased ){ O.push_back( C.obj ); V.push_back( C.val ); }
+      }
+      O.insert( O.end(), object.begin() + i, object.end() );
+      V.insert( V.end(), value .begin() + i, value .end() );
+      object.swap( O );
+      value .swap( V );
+      pending.clear();
+    }
+
+  public:
+
+    Column(): object{}, value{}, pending{}{}
+
+    void put ( Identity obj, T val ){ pending.push_back( Change{ obj, false, val } ); }
+    void excl( Identity obj        ){ pending.push_back( Change{ obj, true,  T{} } ); }
+
+    void clear(){ object.clear(); value.clear(); pending.clear(); }
+
+    size_t size(){ merge(); return object.size(); }
+
+    std::span< const Identity > objects(){ merge(); return object; }
+    std::span< const T        > values (){ merge(); return value;  }
+
+    const T* get( Identity obj ){
+      merge();
+      const auto it{ std::lower_bound( object.begin(), object.end(), obj ) };
+      if( it == object.end() or *it != obj ) return nullptr;
+      return &value[ size_t( it - object.begin() ) ];
+    }
+
+    Summary< T > summary(){ merge(); return Kernel::summary( std::span< const T >( value ) ); }
+
+    Summary< T > summary( std::span< const Identity > subset ){
+                                                                                                                              /*
+      Aggregate values of the objects from sorted `subset`; matching values gathered into
+      contiguous buffer by merge-like pass (galloping when subset is much smaller):
+                                                                                                                              */
+      merge();
+      std::vector< T > gathered;
+      gathered.reserve( std::min( subset.size(), value.size() ) );
+      const bool gallop{ subset.size()*16 < object.size() };
+      auto it{ object.begin() };
+      for( const Identity id: subset ){
+        if( gallop ) it = std::lower_bound( it, object.end(), id );
+        else while( it != object.end() and *it < id ) ++it;
+        if( it == object.end() ) break;
+        if( *it == id ) gathered.push_back( value[ size_t( it - object.begin() ) ] );
+      }
+      return Kernel::summary( std::span< const T >( gathered ) );
+    }
+
+    std::vector< size_t > histogram( T lo, T hi, unsigned bins ){
+      merge();
+      std::vector< size_t > H( bins, 0 );
+      Kernel::histogram< T >( value, lo, hi, H );
+      return H;
+    }
+
+  };//class Column
+
+}//namespace CoreAGI::Data
+
+#endif // DATA_COLUMN_H_INCLUDED
@@ -0,0 +1,133 @@
+                                                                                                                              /*
+ Copyright Mykola Rabchevskiy 2021.
+ Distributed under the Boost Software License, Version 1.0.
+ (See http://www.boost.org/LICENSE_1_0.txt)
+ ______________________________________________________________________________
+
+  Intervals - values of the Span-valued attribute with interval index: spans of the
+  objects sorted by the left end form implicit balanced tree (middle of the range is
+  the root of the range), each node augmented by max right end over its subtree, so
+  stabbing and overlap queries cost O(log n + k) without node allocation.
+
+  Changes accumulated in the `value` table; tree rebuilt before the next query.
+
+  2026.10.19 Initial version
+________________________________________________________________________________________________________________________________
+                                                                                                                              */
+#ifndef DATA_INTERVAL_H_INCLUDED
+#define DATA_INTERVAL_H_INCLUDED
+
+#include <algorithm>
+#include <vector>
+
+#include "def.h"
+#include "flat_hash.h"
+
+namespace CoreAGI::Data {
+
+  class Intervals {
+
+    struct Node {
+      Span     span;
+      Identity obj;
+    };
+
+    ska::flat_hash_map< Identity, Span > value;  // :span of each object
+    std::vector< Node   >                node;   // :sorted by the left end
+    std::vector< double >                reach;  // :reach[m] - max right end of the subtree rooted at `m`
+    bool                                 dirty;  // :tree does not reflect `value`
+
+    double build( size_t lo, size_t hi ){
+      const size_t m{ ( lo + hi )/2 };
+      double r{ node[m].span.t };
+      if( lo < m     ) r = std::max( r, build( lo, m ) );
+      if( m + 1 < hi ) r = std::max( r, build( m + 1, hi ) );
+      return reach[m] = r;
+    }
+
+    void rebuild(){
+      if( not dirty ) return;
+      node.clear();
+      node.reserve( value.size() );
+      for( const auto& [ obj, span ]: value ) node.push_back( Node{ span, obj } );
+      std::sort( node.begin(), node.end(), []( const Node& a, const Node& b ){
+        return a.span.o < b.span.o or ( a.span.o == b.span.o and ( a.span.t < b.span.t or ( a.span.t == b.span.t and a.obj < b.obj ) ) );
+      });
+      reach.assign( node.size(), 0.0 );
+      if( not node.empty() ) build( 0, node.size() );
+      dirty = false;
+    }
+
+    template< typename F > bool overlap( size_t lo, size_t hi, const Span& S, F& f ) const {
+                                                                                                                              /*
+      Subtree skipped if its max right end is left to `S`; right subtree skipped if the root
+      starts right to `S`; `false` returned when `f` breaks the search:
+                                                                                                                              */
+      if( lo >= hi ) return true;
+      const size_t m{ ( lo + hi )/2 };
+      if( reach[m] < S.o ) return true;
+      if( not overlap( lo, m, S, f ) ) return false;
+      if( node[m].span.o > S.t ) return true;
+      if( node[m].span.t >= S.o and not f( node[m].obj, node[m].span ) ) return false;
+      return overlap( m + 1, hi, S, f );
+    }
+
+  public:
+
+    Intervals(): value{}, node{}, reach{}, dirty{ false }{}
+
+    void put ( Identity obj, const Span& span ){ value.insert_or_assign( obj, span ); dirty = true; }
+    void excl( Identity obj                   ){ if( value.erase( obj ) ) dirty = true; }
+
+    void clear(){ value.clear(); node.clear(); reach.clear(); dirty = false; }
+
+    size_t size() const { return value.size(); }
+
+    const Span* get( Identity obj ) const {
+      const auto it{ value.find( obj ) };
+      return it == value.end() ? nullptr : &it->second;
+    }
+
+    template< typename F > size_t overlap( const Span& S, F f ){
+                                                                                                                              /*
+      Call `f( obj, span )` for each span that has common point with `S` (ends included)
+      in ascending order of the left ends; `f` returns `false` to break; returns number of calls:
+                                                                                                                              */
+      rebuild();
+      size_t n{ 0 };
+      auto g = [&]( Identity obj, const Span& span )->bool{ n++; return f( obj, span ); };
+      overlap( 0, node.size(), S, g );
+      return n;
+    }
+
+    template< typename F > size_t stab( double x, F f ){ return overlap( Span( x, x ), f ); }
+
+    template< typename F > size_t join( Intervals& B, F f ){
+                                                                                                                              /*
+      Call `f( objA, objB, affinity )` for each pair of overlapping spans of this and `B`,
+      where affinity is `spanA / spanB`; smaller set drives the search in the index of other:
+                                                                                                                              */
+      rebuild();
+      B.rebuild();
+      size_t n{ 0 };
+      const bool swapped{ B.size() < size() };
+      Intervals& driver{ swapped ? B : *this };
+      Intervals& probed{ swapped ? *this : B };
+      for( const Node& d: driver.node ){
+        probed.overlap( d.span, [&]( Identity obj, const Span& span )->bool{
+          n++;
+          if( swapped ) f( obj, d.obj, span/d.span );
+          else          f( d.obj, obj, d.span/span );
+          return true;
+        });
+      }
+      return n;
+    }
+
+    template< typename F > void each( F f ) const { for( const auto& [ obj, span ]: value ) f( obj, span ); }
+
+  };//class Intervals
+
+}//namespace CoreAGI::Data
+
+#endif // DATA_INTERVAL_H_INCLUDED
@@ -13,6 +13,29 @@
   2021.06.07 Added clear( Identity, bool )
 
   2021.06.13 Modified event processing
+
+  2026.10.19 Mini.save(..) / Mini.load(..): compact binary image with records sorted by key
+
+  2026.10.19 Mini image saved and loaded together with the Gnosis image or checkpoint
+             (see `Gnosis.onPersistIncl(..)`); Mini.load(..) checks header before allocation;
+             Mini.serialize(..) makes image in memory, so it taken together with frozen graph
+
+  2026.10.19 Mini keeps values in flat open-addressing table plus ordered index of the Morton
+             keys; Mini.attributes(..) / Mini.objects(..) are range scans over the index
+
+  2026.10.19 Strings longer than 15 chars are interned in the `Strings` pool and referred
+             by 32-bit handle, so Cargo stays 16 bytes and trivially copyable
+
+  2026.10.19 Numeric attributes can be mirrored into columns (see `data.column.h`) for aggregates
+
+  2026.10.19 Ordered range index of numeric attributes (see `data.range.h`) and Mini.selectIntegers(..) /
+             Mini.selectRationals(..)
+             of objects by value range
+
+  2026.10.19 Span-valued attributes kept in interval index (see `data.interval.h`): stabbing,
+             overlap and Affinity-classified join queries
+
+  2026.10.19 Storage.version(): counter of modifications (used to validate rendering cache)
 ________________________________________________________________________________________________________________________________
                                                                                                                               */
 
@@ -20,13 +43,28 @@ ________________________________________________________________________________
 #define DATA_MINI_H_INCLUDED
 
 
+#include <unistd.h>        // :fsync                                                                           // [+] 2026.10.19
 #include <cstring>
 
+#include <algorithm>                                                                                           // [+] 2026.10.19
+#include <atomic>                                                                                              // [+] 2026.10.19
+#include <bit>             // :countl_zero                                                                     // [+] 2026.10.19
+#include <filesystem>                                                                                          // [+] 2026.10.19
 #include <functional>
-#include <unordered_map>
+#include <map>                                                                                                 // [+] 2026.10.19
+#include <mutex>                                                                                               // [+] 2026.10.19
+#include <string_view>                                                                                         // [+] 2026.10.19
+#include <type_traits>                                                                                         // [+] 2026.10.19
+#include <vector>                                                                                              // [+] 2026.10.19
 
 #include "ancillary.h"
+#include "codec.h"         // :varint                                                                          // [+] 2026.10.19
+#include "crc.h"                                                                                               // [+] 2026.10.19
+#include "data.column.h"                                                                                       // [+] 2026.10.19
+#include "data.interval.h"                                                                                     // [+] 2026.10.19
+#include "data.range.h"                                                                                        // [+] 2026.10.19
 #include "def.h"
+#include "flat_hash.h"                                                                                         // [+] 2026.10.19
 
 namespace CoreAGI::Data {
 
@@ -39,15 +77,88 @@ namespace CoreAGI::Data {
   constexpr unsigned LAST{ CARGO_CAPACITY - 1 };
 
   struct Lex{ char data[ CARGO_CAPACITY ]; };
+                                                                                                                              /*
+  Pool of interned strings: append-only arena of chunks; each distinct string stored once
+  (zero-terminated) and referred by 32-bit handle (chunk number and offset). Strings never
+  released. Interning serialized by mutex, access by handle is lock-free:
+                                                                                                                              */
+  class Strings {                                                                                              // [+] 2026.10.19
+
+    static constexpr unsigned CHUNK_BITS{ 20                           };
+    static constexpr size_t   CHUNK     { size_t( 1 ) << CHUNK_BITS    }; // :bytes; longer string gets own chunk
+    static constexpr unsigned CHUNKS    { 1u << ( 32 - CHUNK_BITS )    };
+
+    std::atomic< char* >                             chunk[ CHUNKS ];
+    unsigned                                         chunks; // :allocated
+    size_t                                           used;   // :bytes of the last chunk
+    size_t                                           total;  // :bytes of all strings
+    ska::flat_hash_map< std::string_view, uint32_t > index;  // :views refer the chunks
+    std::mutex                                       mutex;
+
+    Strings(): chunks{ 0 }, used{ CHUNK }, total{ 0 }, index{}, mutex{}{
+      for( auto& c: chunk ) c.store( nullptr, std::memory_order_relaxed );
+    }
+
+   ~Strings(){ for( unsigned i = 0; i < chunks; i++ ) delete[] chunk[i].load(); }
+
+  public:
+
+    Strings( const Strings& ) = delete;
+    Strings& operator = ( const Strings& ) = delete;
+
+    static Strings& pool(){
+      static Strings S;
+      return S;
+    }
 
+    bool intern( std::string_view s, uint32_t& handle ){
+                                                                                                                              /*
+      Handle of the string (stored if new); `false` if pool exhausted:
+                                                                                                                              */
+      std::lock_guard< std::mutex > lock( mutex );
+      const auto found{ index.find( s ) };
+      if( found != index.end() ){ handle = found->second; return true; }
+      const size_t need{ s.size() + 1 };
+      if( used + need > CHUNK ){
+        if( chunks == CHUNKS ) return false;
+        chunk[ chunks ].store( new char[ std::max( need, CHUNK ) ], std::memory_order_release );
+        chunks++;
+        used = 0;
+      }
+      char* at{ chunk[ chunks - 1 ].load( std::memory_order_relaxed ) + used };
+      memcpy( at, s.data(), s.size() );
+      at[ s.size() ] = '\0';
+      handle = ( ( chunks - 1 ) << CHUNK_BITS ) | uint32_t( used );
+      used  += need;
+      total += need;
+      index.emplace( std::string_view( at, s.size() ), handle );
+      return true;
+    }
+
+    const char* at( uint32_t handle ) const {
+      return chunk[ handle >> CHUNK_BITS ].load( std::memory_order_acquire ) + ( handle & ( CHUNK - 1 ) );
+    }
+
+    size_t size () { std::lock_guard< std::mutex > lock( mutex ); return index.size(); }
+    size_t bytes() { std::lock_guard< std::mutex > lock( mutex ); return total;        }
+
+  };//class Strings
+                                                                                                                              /*
+  Value of the attribute; type tag kept in the last byte: 'i' integer, 'r' rational, 'n' none,
+  '\0' string up to LAST chars kept in place, 's' longer string interned in the `Strings` pool,
+  'p' span (value itself kept by the storage in the interval index of the attribute):
+                                                                                                                              */
   union Cargo {
 
     static_assert( CARGO_CAPACITY > sizeof( int64_t ) );
 
+    struct Ref { uint32_t handle; uint32_t length; }; // :of the interned string                              // [+] 2026.10.19
+
     int64_t  integer;
     double   rational;
 //  Identity identity;
     Lex      lex;
+    Ref      ref;                                                                                              // [+] 2026.10.19
 
     Cargo(): integer{ 0 }{ lex.data[ LAST ] = 'n'; }
 
@@ -55,34 +166,118 @@ namespace CoreAGI::Data {
     explicit Cargo( double   r ): rational{ r }{ lex.data[ LAST ] = 'r'; }
 //  explicit Cargo( Identity e ): identity{ e }{ lex.data[ LAST ] = 'e'; }
 
-    explicit Cargo( const char* s ){
+    explicit Cargo( std::string_view s ){                                                                      // [m] 2026.10.19
       memset( lex.data, 0, CARGO_CAPACITY );
-      unsigned i  { 0        };
-      char*    out{ lex.data };
-      for( const char* src = s; *src and i < LAST; src++, i++ ) *out++ = *src;
-      assert( lex.data[ LAST ] == '\0' );
+      if( s.size() > LAST and Strings::pool().intern( s, ref.handle ) ){
+        ref.length        = uint32_t( s.size() );
+        lex.data[ LAST ] = 's';
+        return;
+      }
+      memcpy( lex.data, s.data(), std::min< size_t >( s.size(), LAST ) ); // :truncated if pool exhausted
     }
 
-    explicit Cargo( const std::string s ){
-      memset( lex.data, 0, CARGO_CAPACITY );
-      unsigned i  { 0        };
-      char*    out{ lex.data };
-      for( const char* src = s.c_str(); *src and i < LAST; src++, i++ ) *out++ = *src;
-      assert( lex.data[ LAST ] == '\0' );
+    explicit Cargo( const char*        s ): Cargo( std::string_view( s ) ){}                                  // [m] 2026.10.19
+    explicit Cargo( const std::string& s ): Cargo( std::string_view( s ) ){}                                  // [m] 2026.10.19
+
+    char type() const { return lex.data[ LAST ]; }                                                             // [m] 2026.10.19
+
+    bool string() const { return type() == '\0' or type() == 's'; }                                           // [+] 2026.10.19
+
+    const char* c_str() const {                                                                                // [+] 2026.10.19
+      return type() == 's' ? Strings::pool().at( ref.handle ) : lex.data;
     }
 
-    char type(){ return lex.data[ LAST ]; }
+    std::string_view view() const {                                                                            // [+] 2026.10.19
+      return type() == 's' ? std::string_view( Strings::pool().at( ref.handle ), ref.length ) : std::string_view( lex.data );
+    }
+                                                                                                                              /*
+    Portable encoding of the value (used by `Mini` image and journaled batches): type tag followed
+    by zigzag varint for integer, 8 bytes for rational, length and chars for string (interned
+    one too), nothing for empty cargo and span (span written by caller), whole `lex` otherwise:
+                                                                                                                              */
+    static void pack( std::vector< uint8_t >& out, const Cargo& val ){                                         // [+] 2026.10.19
+      const char tag{ val.lex.data[ LAST ] };
+      out.push_back( uint8_t( tag ) );
+      switch( tag ){
+        case 'n': break;
+        case 'p': break; // :span written by caller                                                            // [+] 2026.10.19
+        case 'i': putVarint( out, uint64_t( val.integer << 1 ) ^ uint64_t( val.integer >> 63 ) ); break;
+        case 'r': out.insert( out.end(), val.lex.data, val.lex.data + sizeof( double ) ); break;
+        case '\0': {
+          const size_t n{ strnlen( val.lex.data, LAST ) };
+          out.push_back( uint8_t( n ) );
+          out.insert( out.end(), val.lex.data, val.lex.data + n );
+          break;
+        }
+        case 's': {                                                                                            // [+] 2026.10.19
+          const std::string_view str{ val.view() };
+          putVarint( out, uint32_t( str.size() ) );
+          out.insert( out.end(), str.begin(), str.end() );
+          break;
+        }
+        default: out.insert( out.end(), val.lex.data, val.lex.data + LAST ); break;
+      }
+    }
 
+    static bool unpack( const uint8_t*& p, const uint8_t* end, Cargo& val ){                                   // [+] 2026.10.19
+      if( p >= end ) return false;
+      const char tag( *p++ );
+      memset( val.lex.data, 0, CARGO_CAPACITY );
+      val.lex.data[ LAST ] = tag;
+      switch( tag ){
+        case 'n': return true;
+        case 'p': return true; // :span read by caller                                                         // [+] 2026.10.19
+        case 'i': {
+          uint64_t u;
+          if( not getVarint( p, end, u ) ) return false;
+          val.integer = int64_t( u >> 1 ) ^ -int64_t( u & 1 );
+          return true;
+        }
+        case 'r':
+          if( end - p < long( sizeof( double ) ) ) return false;
+          memcpy( val.lex.data, p, sizeof( double ) );
+          p += sizeof( double );
+          return true;
+        case '\0': {
+          if( p >= end ) return false;
+          const size_t n{ *p++ };
+          if( n > LAST or size_t( end - p ) < n ) return false; // :`LAST` chars fill whole `lex`
+          memcpy( val.lex.data, p, n );
+          p += n;
+          return true;
+        }
+        case 's': {                                                                                            // [+] 2026.10.19
+          uint32_t n;
+          if( not getVarint( p, end, n ) or n <= LAST or size_t( end - p ) < n ) return false;
+          val = Cargo( std::string_view( reinterpret_cast< const char* >( p ), n ) );
+          p += n;
+          return val.type() == 's';
+        }
+        default:
+          if( end - p < long( LAST ) ) return false;
+          memcpy( val.lex.data, p, LAST );
+          p += LAST;
+          return true;
+      }
+    }
   };//Cargo
+
+  static_assert( sizeof( Cargo ) == CARGO_CAPACITY and std::is_trivially_copyable_v< Cargo > );               // [+] 2026.10.19
                                                                                                                               /*
   Quasy-abstract data storage base class:
                                                                                                                               */
   class Storage: public Ancillary {
 
+  protected:
+
+    uint64_t revision{ 0 }; // :incremented by each modification                                              // [+] 2026.10.19
+
   public:
 
     Storage( const char* title, Logger& logger, Gnosis& gnosis ): Ancillary( title, logger, gnosis ){}
 
+    uint64_t version() const { return revision; }                                                              // [+] 2026.10.19
+
     Storage            ( const Storage& ) = delete;
     Storage& operator= ( const Storage& ) = delete;
 
@@ -113,6 +308,12 @@ namespace CoreAGI::Data {
     virtual const Cargo* get( const Entity& obj, const Entity& atr ) const { return get( key( obj, atr ) ); }
     virtual       Cargo* get( const Entity& obj, const Entity& atr )       { return get( key( obj, atr ) ); }
 
+    virtual void        put ( const Key&, const Span& ){ assert( false ); }                                    // [+] 2026.10.19
+    virtual const Span* span( const Key& ) const { return nullptr; }                                           // [+] 2026.10.19
+
+    virtual void        put ( const Entity& obj, const Entity& atr, const Span& val ){ put( key( obj, atr ), val ); } // [+] 2026.10.19
+    virtual const Span* span( const Entity& obj, const Entity& atr ) const { return span( key( obj, atr ) ); }     // [+] 2026.10.19
+
     virtual bool save( const char* path ) const { log.vital( "`save()` not yet implemented" ); return false; }
     virtual bool load( const char* path )       { log.vital( "`load()` not yet implemented" ); return false; }
 
@@ -122,55 +323,319 @@ namespace CoreAGI::Data {
                                                                                                                               */
 
   class Mini: public Storage {
-
-    std::unordered_map< Key, Cargo > data;
+                                                                                                                              /*
+    Values kept in flat open-addressing table (no node per value). Key is Morton combination
+    of object and attribute (object bits at even positions, see `combination(..)`), so keys of
+    one object (or one attribute) are scattered over the key range but can be found by range
+    scan that skips gaps (see `scan(..)`). Ordered index is sorted vector of keys; new keys
+    accumulated in `fresh` and merged before scan, erased keys purged lazily:
+                                                                                                                              */
+    static constexpr Key OBJECT   { Morton::EVEN }; // :bits of the object in the key                         // [+] 2026.10.19
+    static constexpr Key ATTRIBUTE{ Morton::ODD  }; // :bits of the attribute in the key
+
+    ska::flat_hash_map< Key, Cargo > data;                                                                     // [m] 2026.10.19
+    mutable std::vector< Key >       sorted;   // :ordered index; may contain erased keys                      // [+] 2026.10.19
+    mutable std::vector< Key >       fresh;    // :keys added after the last merge                             // [+] 2026.10.19
+    mutable size_t                   stale;    // :number of erased keys in the index                          // [+] 2026.10.19
+    std::map< Identity, Column< int64_t > > integers;  // :columns of the integer attributes                   // [+] 2026.10.19
+    std::map< Identity, Column< double  > > rationals; // :columns of the rational attributes                  // [+] 2026.10.19
+    std::map< Identity, Range < int64_t > > integerIndex;  // :range indexes of the integer attributes        // [+] 2026.10.19
+    std::map< Identity, Range < double  > > rationalIndex; // :range indexes of the rational attributes       // [+] 2026.10.19
+    std::map< Identity, Intervals         > spans;         // :values of the span attributes                   // [+] 2026.10.19
     Identity                         onForget;
+    Identity                         onPersist;     // :saved and loaded with the graph image                  // [+] 2026.10.19
+                                                                                                                              /*
+    Binary image: header followed by records sorted by key. Record is varint delta of the key
+    and packed value (see `Cargo::pack(..)`); two doubles of the span follow 'p' tag:
+                                                                                                                              */
+    static constexpr char     IMAGE_MAGIC[ 8 ]{ 'G', 'e', 'l', 'D', 'A', 'T', '0', '1' };                      // [+] 2026.10.19
+    static constexpr uint32_t IMAGE_VERSION   { 1          };
+    static constexpr uint32_t IMAGE_ENDIAN    { 0x01020304 }; // :written in native byte order
+
+    struct ImageHeader {                                                                                       // [+] 2026.10.19
+      char     magic[ 8 ];
+      uint32_t version;
+      uint32_t endian;
+      uint64_t count;     // :number of records
+      uint64_t size;      // :bytes of records
+      uint32_t crc;       // :CRC-32 of records
+      uint32_t reserved;
+    };
+
+    static_assert( sizeof( ImageHeader ) == 40 );
+
+    void merge() const {                                                                                       // [+] 2026.10.19
+                                                                                                                              /*
+      Bring ordered index up to date; erased keys purged when they make a quarter of the index:
+                                                                                                                              */
+      auto erased = [this]( Key k ){ return data.find( k ) == data.end(); };
+      if( 4*stale > sorted.size() ){
+        sorted.erase( std::remove_if( sorted.begin(), sorted.end(), erased ), sorted.end() );
+        stale = 0;
+      }
+      if( fresh.empty() ) return;
+      std::sort( fresh.begin(), fresh.end() );
+      const size_t n{ sorted.size() };
+      sorted.insert( sorted.end(), fresh.begin(), fresh.end() );
+      std::inplace_merge( sorted.begin(), sorted.begin() + n, sorted.end() );
+      sorted.erase( std::unique( sorted.begin(), sorted.end() ), sorted.end() ); // :erased and put again
+      fresh.clear();
+    }
+
+    static bool seek( Key k, Key mask, Key value, Key& next ){                                                 // [+] 2026.10.19
+                                                                                                                              /*
+      Smallest `next` >= `k` such that `next & mask == value`; `false` if there is no such key.
+      Highest differing bit of the masked part decides: if `value` has 1 there, take high bits
+      of `k` and lowest possible rest; otherwise increment free (unmasked) bits above it:
+                                                                                                                              */
+      const Key diff{ ( k & mask ) ^ value };
+      if( not diff ){ next = k; return true; }
+      const unsigned p  { unsigned( 63 - std::countl_zero( diff ) ) };
+      const Key      low{ p == 63 ? ~Key( 0 ) : ( Key( 2 ) << p ) - 1 }; // :bits 0..p
+      if( value & ( Key( 1 ) << p ) ){
+        next = ( k & ~low & ~mask ) | value;
+        return true;
+      }
+      const Key up{ ( k | mask | low ) + 1 }; // :carry into the lowest free bit above `p`
+      if( up == 0 ) return false;
+      next = ( up & ~mask ) | value;
+      return true;
+    }
+
+    void mirror( const Key& key, const Cargo* old, const Cargo* val ){                                         // [m] 2026.10.19
+                                                                                                                              /*
+      Reflect change of the value (from `old` to `val`, nullptr if none) in the column and
+      in the range index of the attribute (if any); value of other type is not reflected.
+      Span replaced by value of other type (or removed) is removed from the interval index:
+                                                                                                                              */
+      if( integers.empty() and rationals.empty() and integerIndex.empty() and rationalIndex.empty() and spans.empty() ) return;
+      const Identity atr{ attributeOf( key ) };
+      if( old and old->type() == 'p' and not ( val and val->type() == 'p' ) ){
+        if( const auto it{ spans.find( atr ) }; it != spans.end() ) it->second.excl( objectOf( key ) );
+      }
+      if( const auto it{ integerIndex.find( atr ) }; it != integerIndex.end() ){
+        it->second.change( objectOf( key ), old and old->type() == 'i' ? &old->integer : nullptr,
+                                            val and val->type() == 'i' ? &val->integer : nullptr );
+      }
+      if( const auto it{ rationalIndex.find( atr ) }; it != rationalIndex.end() ){
+        it->second.change( objectOf( key ), old and old->type() == 'r' ? &old->rational : nullptr,
+                                            val and val->type() == 'r' ? &val->rational : nullptr );
+      }
+      if( const auto it{ integers.find( atr ) }; it != integers.end() ){
+        if( val and val->type() == 'i' ) it->second.put( objectOf( key ), val->integer );
+        else                             it->second.excl( objectOf( key ) );
+      }
+      if( const auto it{ rationals.find( atr ) }; it != rationals.end() ){
+        if( val and val->type() == 'r' ) it->second.put( objectOf( key ), val->rational );
+        else                             it->second.excl( objectOf( key ) );
+      }
+    }
+
+    void refill(){                                                                                             // [+] 2026.10.19
+      for( auto& [ atr, column ]: integers  ){ column.clear(); objects( atr, [&]( const Identity& obj, const Cargo& v ){ if( v.type() == 'i' ) column.put( obj, v.integer  ); } ); }
+      for( auto& [ atr, column ]: rationals ){ column.clear(); objects( atr, [&]( const Identity& obj, const Cargo& v ){ if( v.type() == 'r' ) column.put( obj, v.rational ); } ); }
+      for( auto& [ atr, index ]: integerIndex  ){ index.clear(); objects( atr, [&]( const Identity& obj, const Cargo& v ){ if( v.type() == 'i' ) index.change( obj, nullptr, &v.integer  ); } ); }
+      for( auto& [ atr, index ]: rationalIndex ){ index.clear(); objects( atr, [&]( const Identity& obj, const Cargo& v ){ if( v.type() == 'r' ) index.change( obj, nullptr, &v.rational ); } ); }
+    }
+
+    template< typename F > size_t scan( Key mask, Key value, F f ) const {                                     // [+] 2026.10.19
+                                                                                                                              /*
+      Call `f( key, cargo )` for each stored key with `key & mask == value` in ascending order:
+                                                                                                                              */
+      merge();
+      size_t n{ 0 };
+      auto   it{ std::lower_bound( sorted.begin(), sorted.end(), value ) };
+      while( it != sorted.end() ){
+        if( ( *it & mask ) != value ){
+          Key next;
+          if( not seek( *it, mask, value, next ) ) break;
+          it = std::lower_bound( it, sorted.end(), next );
+          continue;
+        }
+        const auto found{ data.find( *it ) };
+        if( found != data.end() ){ f( *it, found->second ); n++; }
+        ++it;
+      }
+      return n;
+    }
 
   public:
 
-    Mini( const char* title, Logger& logger, Gnosis& gnosis): Storage( title, logger, gnosis ), data{}{
+    Mini( const char* title, Logger& logger, Gnosis& gnosis):                                                  // [m] 2026.10.19
+      Storage( title, logger, gnosis ), data{}, sorted{}, fresh{}, stale{ 0 }, integers{}, rationals{}, integerIndex{}, rationalIndex{}, spans{}
+    {
       log.vital( kit( "Cargo size: %lu", sizeof( Cargo ) ) ); // :just in case
       onForget = gnosis.onChangeIdIncl(
         [&]( const Identity& id, const Identity& id2, bool attribute )->void{ change( id, id2, attribute ); }
       );
+      onPersist = gnosis.onPersistIncl(                                                                        // [+] 2026.10.19
+        Config::data::IMAGE,
+        [&]( std::vector< uint8_t >& out )->void{ serialize( out ); },
+        [&]( const char* path )->bool{ return load( path ); }
+      );
+    }
+
+   ~Mini(){                                                                                                    // [+] 2026.10.19
+      gnosis.onChangeIdExcl( onForget  );
+      gnosis.onPersistExcl ( onPersist );
     }
 
     virtual size_t size    (                ) const override { return data.size();          }
     virtual bool   empty   (                ) const override { return data.empty();         }
-    virtual bool   contains( const Key& key ) const override { return data.contains( key ); }                  // [+] 2021.05.31
+    virtual bool   contains( const Key& key ) const override { return data.find( key ) != data.end(); }        // [m] 2026.10.19
 
     virtual size_t clear() override {                                                                          // [m] 2021.06.07
       auto n{ data.size() };
+      revision++;                                                                                              // [+] 2026.10.19
       data.clear();
+      sorted.clear();                                                                                          // [+] 2026.10.19
+      fresh .clear();
+      stale = 0;
+      for( auto& [ atr, column ]: integers  ) column.clear();                                                  // [+] 2026.10.19
+      for( auto& [ atr, column ]: rationals ) column.clear();
+      for( auto& [ atr, index  ]: integerIndex  ) index.clear();                                               // [+] 2026.10.19
+      for( auto& [ atr, index  ]: rationalIndex ) index.clear();
+      spans.clear();                                                                                           // [+] 2026.10.19
       return n;
     }
 
     virtual size_t change( const Identity& id, const Identity& id2, bool attribute ) override {                // [m] 2021.06.13
-      std::vector< Key > K; // :list of keys to be replaced/removed
-      if( id2 == CoreAGI::NIHIL ){
                                                                                                                               /*
-        Entity referred by `id` will be deleted:
+      Keys of the entity found by range scan instead of the whole table traversal:
                                                                                                                               */
-        for( const auto& [ k, v ]: data ){
-          const auto& [ obj, atr ] = decombine( k );
-          if( attribute ){ if( atr == id ) K.push_back( k ); }
-          else           { if( obj == id ) K.push_back( k ); }
-        }
-        for( const auto& k: K ) data.erase( k );
-      } else {
+      std::vector< std::pair< Key, Cargo > > K; // :list of keys to be replaced/removed                         // [m] 2026.10.19
+      if( attribute ) scan( ATTRIBUTE, combination( CoreAGI::NIHIL, id ), [&]( Key k, const Cargo& v ){ K.emplace_back( k, v ); } );
+      else            scan( OBJECT,    combination( id, CoreAGI::NIHIL ), [&]( Key k, const Cargo& v ){ K.emplace_back( k, v ); } );
+      std::vector< Span > P; // :spans of the keys with 'p' values                                              // [+] 2026.10.19
+      for( const auto& [ k, v ]: K ) if( v.type() == 'p' ) P.push_back( *span( k ) );
+      for( const auto& [ k, v ]: K ) excl( k );
+      if( id2 != CoreAGI::NIHIL ){
                                                                                                                               /*
         Entity referred by `id` will change ID to `id2`:
                                                                                                                               */
-        for( const auto& [ k, v ]: data ){
-          const auto& [ obj, atr ] = decombine( k );
-          if( attribute ){ if( atr == id ) data.insert_or_assign( key( obj, id2 ), v ), K.push_back( k ); }
-          else           { if( obj == id ) data.insert_or_assign( key( id2, atr ), v ), K.push_back( k ); }
+        const Key replaced{ attribute ? combination( CoreAGI::NIHIL, id2 ) : combination( id2, CoreAGI::NIHIL ) };
+        size_t p{ 0 };
+        for( const auto& [ k, v ]: K ){
+          const Key k2{ ( k & ( attribute ? OBJECT : ATTRIBUTE ) ) | replaced }; // :other part kept
+          if( v.type() == 'p' ) put( k2, P[ p++ ] );                                                           // [m] 2026.10.19
+          else                  put( k2, v        );
         }
-        for( const auto& k: K ) data.erase( k );
       }
       return K.size();
     }
 
+    size_t attributes( const Identity& obj, std::function< void( const Identity& atr, const Cargo& val ) > f ) const { // [+] 2026.10.19
+                                                                                                                              /*
+      Visit all attributes of the object (in ascending order of the keys); returns their number:
+                                                                                                                              */
+      return scan( OBJECT, combination( obj, CoreAGI::NIHIL ), [&]( Key k, const Cargo& v ){ f( attributeOf( k ), v ); } );
+    }
+
+    size_t objects( const Identity& atr, std::function< void( const Identity& obj, const Cargo& val ) > f ) const { // [+] 2026.10.19
+                                                                                                                              /*
+      Visit all objects that have the attribute; returns their number:
+                                                                                                                              */
+      return scan( ATTRIBUTE, combination( CoreAGI::NIHIL, atr ), [&]( Key k, const Cargo& v ){ f( objectOf( k ), v ); } );
+    }
+
+    bool columnar( const Identity& atr, char type ){                                                           // [+] 2026.10.19
+                                                                                                                              /*
+      Keep values of the attribute also in the column: `type` is 'i' (integer) or 'r' (rational);
+      values of other types are not mirrored. Column filled from the current content:
+                                                                                                                              */
+      if( type != 'i' and type != 'r' ){ log.vital( kit( "Column of type `%c` not supported", type ) ); return false; }
+      if( integers.contains( atr ) or rationals.contains( atr ) ) return true;
+      if( type == 'i' ) integers [ atr ];
+      else              rationals[ atr ];
+      refill();
+      return true;
+    }
+
+    bool indexed( const Identity& atr, char type ){                                                            // [+] 2026.10.19
+                                                                                                                              /*
+      Maintain range index of the attribute: `type` is 'i' (integer) or 'r' (rational); values
+      of other types are not indexed. Index filled from the current content:
+                                                                                                                              */
+      if( type != 'i' and type != 'r' ){ log.vital( kit( "Index of type `%c` not supported", type ) ); return false; }
+      if( integerIndex.contains( atr ) or rationalIndex.contains( atr ) ) return true;
+      if( type == 'i' ) integerIndex [ atr ];
+      else              rationalIndex[ atr ];
+      refill();
+      return true;
+    }
+
+    std::vector< Identity > selectIntegers( const Identity& atr, int64_t lo, int64_t hi ){                     // [+] 2026.10.19
+                                                                                                                              /*
+      Objects whose integer attribute lies in [lo, hi] sorted by ID; without index - by scan:
+                                                                                                                              */
+      if( const auto it{ integerIndex.find( atr ) }; it != integerIndex.end() ) return it->second.select( lo, hi );
+      std::vector< Identity > R;
+      objects( atr, [&]( const Identity& obj, const Cargo& v ){ if( v.type() == 'i' and lo <= v.integer and v.integer <= hi ) R.push_back( obj ); } );
+      std::sort( R.begin(), R.end() );
+      return R;
+    }
+
+    std::vector< Identity > selectRationals( const Identity& atr, double lo, double hi ){                      // [+] 2026.10.19
+                                                                                                                              /*
+      Objects whose rational attribute lies in [lo, hi] sorted by ID; without index - by scan:
+                                                                                                                              */
+      if( const auto it{ rationalIndex.find( atr ) }; it != rationalIndex.end() ) return it->second.select( lo, hi );
+      std::vector< Identity > R;
+      objects( atr, [&]( const Identity& obj, const Cargo& v ){ if( v.type() == 'r' and lo <= v.rational and v.rational <= hi ) R.push_back( obj ); } );
+      std::sort( R.begin(), R.end() );
+      return R;
+    }
+
+    virtual void put( const Key& key, const Span& val ) override {                                             // [+] 2026.10.19
+                                                                                                                              /*
+      Storage keeps marker 'p' under the key; span itself kept in the interval index:
+                                                                                                                              */
+      Cargo mark;
+      mark.lex.data[ LAST ] = 'p';
+      put( key, mark );
+      spans[ attributeOf( key ) ].put( objectOf( key ), val );
+    }
+
+    virtual const Span* span( const Key& key ) const override {                                                // [+] 2026.10.19
+      const auto it{ spans.find( attributeOf( key ) ) };
+      return it == spans.end() ? nullptr : it->second.get( objectOf( key ) );
+    }
+
+    using Storage::put;                                                                                        // [+] 2026.10.19
+    using Storage::span;
+
+    size_t stab( const Identity& atr, double x, std::function< void( const Identity& obj, const Span& val ) > f ){ // [+] 2026.10.19
+                                                                                                                              /*
+      Visit objects whose span attribute contains `x`; returns their number:
+                                                                                                                              */
+      const auto it{ spans.find( atr ) };
+      if( it == spans.end() ) return 0;
+      return it->second.stab( x, [&]( Identity obj, const Span& val ){ f( obj, val ); return true; } );
+    }
+
+    size_t overlap( const Identity& atr, const Span& S, std::function< void( const Identity& obj, const Span& val ) > f ){ // [+] 2026.10.19
+                                                                                                                              /*
+      Visit objects whose span attribute has common point with `S`; returns their number:
+                                                                                                                              */
+      const auto it{ spans.find( atr ) };
+      if( it == spans.end() ) return 0;
+      return it->second.overlap( S, [&]( Identity obj, const Span& val ){ f( obj, val ); return true; } );
+    }
+
+    size_t join( const Identity& atrA, const Identity& atrB,                                                   // [+] 2026.10.19
+                 std::function< void( const Identity& objA, const Identity& objB, Affinity affinity ) > f ){
+                                                                                                                              /*
+      Visit pairs of objects with overlapping spans of `atrA` and `atrB` with their Affinity:
+                                                                                                                              */
+      const auto A{ spans.find( atrA ) };
+      const auto B{ spans.find( atrB ) };
+      if( A == spans.end() or B == spans.end() ) return 0;
+      return A->second.join( B->second, f );
+    }
+
+    Column< int64_t >* integer ( const Identity& atr ){ const auto it{ integers .find( atr ) }; return it == integers .end() ? nullptr : &it->second; } // [+] 2026.10.19
+    Column< double  >* rational( const Identity& atr ){ const auto it{ rationals.find( atr ) }; return it == rationals.end() ? nullptr : &it->second; } // [+] 2026.10.19
+
     virtual Cargo* get( const Key& key ) override {
       const auto& it{ data.find( key ) };
       if( it == data.end() ) return nullptr;
@@ -183,10 +648,22 @@ namespace CoreAGI::Data {
       return &( it->second );
     }
 
-    virtual void excl( const Key& key ) override { data.erase( key ); };
+    virtual void excl( const Key& key ) override {                                                             // [m] 2026.10.19
+      const auto it{ data.find( key ) };
+      if( it == data.end() ) return;
+      mirror( key, &it->second, nullptr );
+      data.erase( it );
+      stale++;
+      revision++;
+    };
 
     virtual void put( const Key& key, const Cargo& val ) override {
-      data.insert_or_assign( key, val );
+      const auto it{ data.find( key ) };                                                                       // [m] 2026.10.19
+      mirror( key, it == data.end() ? nullptr : &it->second, &val ); // :before insertion that may invalidate `val` referred into the table
+      revision++;
+      if( it != data.end() ){ it->second = val; return; }
+      data.emplace( key, val );
+      fresh.push_back( key );
     }
 
     virtual const Cargo* get( const Entity& obj, const Entity& atr ) const { return get( key( obj, atr ) ); }
@@ -195,6 +672,135 @@ namespace CoreAGI::Data {
     virtual void put ( const Entity& obj, const Entity& atr, const Cargo& val ){ put ( key( obj, atr ), val ); }
     virtual void excl( const Entity& obj, const Entity& atr, const Cargo& val ){ excl( key( obj, atr )      ); }
 
+    size_t serialize( std::vector< uint8_t >& out ) const {                                                    // [+] 2026.10.19
+                                                                                                                              /*
+      Binary image in memory (see `save(..)`); returns number of records:
+                                                                                                                              */
+      out.clear();
+      out.reserve( sizeof( ImageHeader ) + 8*data.size() );
+      out.resize( sizeof( ImageHeader ) );
+      Key prev{ 0 };
+      const size_t n = scan( 0, 0, [&]( Key k, const Cargo& v ){ // :all keys in ascending order                 // [m] 2026.10.19
+        putVarint( out, k - prev );
+        Cargo::pack( out, v );                                                                                 // [m] 2026.10.19
+        if( v.type() == 'p' ){                                                                                 // [+] 2026.10.19
+          const Span* S{ span( k ) };
+          const Span  none{};
+          const auto* b{ reinterpret_cast< const uint8_t* >( S ? S : &none ) };
+          out.insert( out.end(), b, b + sizeof( Span ) );
+        }
+        prev = k;
+      });
+      ImageHeader header{};
+      memcpy( header.magic, IMAGE_MAGIC, sizeof( header.magic ) );
+      header.version = IMAGE_VERSION;
+      header.endian  = IMAGE_ENDIAN;
+      header.count   = n;
+      header.size    = out.size() - sizeof( ImageHeader );
+      header.crc     = crc32( out.data() + sizeof( ImageHeader ), header.size );
+      memcpy( out.data(), &header, sizeof( header ) );
+      return n;
+    }
+
+    virtual bool save( const char* path ) const override {                                                     // [+] 2026.10.19
+                                                                                                                              /*
+      Save binary image (usually `Config::data::IMAGE` in the folder of the Gnosis image);
+      temporary file renamed after written, so existing image is never damaged:
+                                                                                                                              */
+      namespace fs = std::filesystem;
+      log( kit( "Save as `%s`...", path ) ); log.flush();
+      Timer timer;
+      std::vector< uint8_t > out;
+      const size_t n{ serialize( out ) };
+      const fs::path pathTemp{ std::string( path ) + "~" };
+      FILE* dst = fopen( pathTemp.string().c_str(), "wb" );
+      if( not dst ){ log.vital( kit( "  Can`t create `%s`", pathTemp.string().c_str() ) ); return false; }
+      bool ok = fwrite( out.data(), 1, out.size(), dst ) == out.size();
+      ok = ( fflush( dst ) == 0 ) and ok;
+      ok = ok and ( fsync( fileno( dst ) ) == 0 );
+      ok = ( fclose( dst ) == 0 ) and ok;
+      std::error_code error;
+      if( ok ) fs::rename( pathTemp, path, error );
+      if( not ok or error ){
+        log.vital( kit( "  Can`t write `%s`", path ) ); log.flush();
+        fs::remove( pathTemp, error );
+        return false;
+      }
+      log( kit( "  [ok] stored %lu records (%lu bytes) in %.3f msec", n, out.size(), timer.elapsed( Timer::MILLISEC ) ) );
+      return true;
+    }
+
+    virtual bool load( const char* path ) override {                                                           // [+] 2026.10.19
+                                                                                                                              /*
+      Load binary image in single pass into pre-sized table that replaces current content
+      only when whole image decoded, so damaged image changes nothing; records are sorted,
+      so ordered index built in the same pass. Header checked against the file before
+      anything allocated:
+                                                                                                                              */
+      log( kit( "Load from `%s`...", path ) ); log.flush();
+      Timer timer;
+      FILE* src = fopen( path, "rb" );
+      if( not src ){ log.vital( kit( "  File `%s` not found", path ) ); log.flush(); return false; }
+      ImageHeader            header;
+      std::vector< uint8_t > records;
+      std::error_code        failure;                                                                          // [+] 2026.10.19
+      const uintmax_t        bytes{ std::filesystem::file_size( path, failure ) };                             // [+] 2026.10.19
+      bool ok = fread( &header, sizeof( header ), 1, src ) == 1;
+      const char* error{ nullptr };
+      if     ( not ok                                                                  ) error = "too short file";
+      else if( memcmp( header.magic, IMAGE_MAGIC, sizeof( header.magic ) )             ) error = "not a data image";
+      else if( header.version != IMAGE_VERSION                                         ) error = "unsupported version";
+      else if( header.endian  != IMAGE_ENDIAN                                          ) error = "alien byte order";
+      else if( failure or header.size != bytes - sizeof( header )                      ) error = "size mismatch"; // [+] 2026.10.19
+      else if( header.count > header.size                                              ) error = "malformed header"; // [+] 2026.10.19
+      else {
+        records.resize( header.size );
+        if( fread( records.data(), 1, records.size(), src ) != records.size() ) error = "truncated file";
+        else if( crc32( records.data(), records.size() ) != header.crc          ) error = "checksum mismatch";
+      }
+      fclose( src );
+      if( error ){ log.vital( kit( "  Image `%s` rejected: %s", path, error ) ); log.flush(); return false; }
+      ska::flat_hash_map< Key, Cargo > items;                                                                  // [m] 2026.10.19
+      std::vector< Key >               keys;
+      std::map< Identity, Intervals >  intervals;                                                              // [+] 2026.10.19
+      items.reserve( header.count );
+      keys .reserve( header.count );
+      const uint8_t* p  { records.data()      };
+      const uint8_t* end{ p + records.size()  };
+      Key            k  { 0                   };
+      while( p < end ){
+        Key   d;
+        Cargo val;
+        if( not getVarint( p, end, d ) or not Cargo::unpack( p, end, val ) or ( d == 0 and not items.empty() )
+            or ( val.type() == 'p' and end - p < long( sizeof( Span ) ) ) ){                                  // [m] 2026.10.19
+          log.vital( kit( "  Image `%s` rejected: malformed record %lu", path, items.size() ) ); log.flush();
+          return false;
+        }
+        k += d;
+        if( val.type() == 'p' ){                                                                               // [+] 2026.10.19
+          Span S;
+          memcpy( &S, p, sizeof( Span ) );
+          p += sizeof( Span );
+          intervals[ attributeOf( k ) ].put( objectOf( k ), S );
+        }
+        items.emplace( k, val );
+        keys .push_back( k );
+      }
+      if( items.size() != header.count ){
+        log.vital( kit( "  Image `%s` rejected: %lu records instead of %lu", path, items.size(), header.count ) );
+        return false;
+      }
+      data  .swap( items );
+      sorted.swap( keys  );
+      spans .swap( intervals );                                                                                // [+] 2026.10.19
+      revision++;
+      fresh .clear();
+      stale = 0;
+      refill();                                                                                                // [+] 2026.10.19
+      log( kit( "  [ok] loaded %lu records in %.3f msec", data.size(), timer.elapsed( Timer::MILLISEC ) ) ); log.flush();
+      return true;
+    }
+
   };//class Mini
 
 }//namespace CoreAGI::Mini
@@ -0,0 +1,123 @@
+                                                                                                                              /*
+ Copyright Mykola Rabchevskiy 2021.
+ Distributed under the Boost Software License, Version 1.0.
+ (See http://www.boost.org/LICENSE_1_0.txt)
+ ______________________________________________________________________________
+
+  Range - ordered secondary index of the numeric attribute: pairs (value, object)
+  kept in sorted array with fence pointers (every FANOUT`th value copied into small
+  array that fits into cache), so selection of the objects with value in [lo, hi]
+  costs O(log n + k) instead of probing storage for each candidate.
+
+  Changes accumulated as lists of added and removed pairs and merged into sorted
+  array in single pass before the next query.
+
+  2026.10.19 Initial version
+________________________________________________________________________________________________________________________________
+                                                                                                                              */
+#ifndef DATA_RANGE_H_INCLUDED
+#define DATA_RANGE_H_INCLUDED
+
+#include <cmath>
+#include <cstdint>
+
+#include <algorithm>
+#include <compare>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+#include "def.h"
+
+namespace CoreAGI::Data {
+
+  template< typename T > class Range {
+
+    static constexpr size_t FANOUT{ 64 }; // :entries per fence
+
+    struct Entry {
+      T        val;
+      Identity obj;
+      auto operator <=> ( const Entry& ) const = default;
+    };
+
+    std::vector< Entry > entry;   // :sorted by value, then by object
+    std::vector< T     > fence;   // :fence[i] == entry[ i*FANOUT ].val
+    std::vector< Entry > added;   // :pending changes
+    std::vector< Entry > removed;
+
+    static bool valid( T val ){ if constexpr( std::is_floating_point_v< T > ) return not std::isnan( val ); else return true; }
+
+    void merge(){
+                                                                                                                              /*
+      Pair added and then removed (or vice versa) cancels out; rest of removed pairs
+      deleted from the array, rest of added ones merged into it:
+                                                                                                                              */
+      if( added.empty() and removed.empty() ) return;
+      std::sort( added  .begin(), added  .end() );
+      std::sort( removed.begin(), removed.end() );
+      std::vector< Entry > plus, minus;
+      std::set_difference( added  .begin(), added  .end(), removed.begin(), removed.end(), std::back_inserter( plus  ) );
+      std::set_difference( removed.begin(), removed.end(), added  .begin(), added  .end(), std::back_inserter( minus ) );
+      added  .clear();
+      removed.clear();
+      std::vector< Entry > kept;
+      kept.reserve( entry.size() + plus.size() );
+      std::set_difference( entry.begin(), entry.end(), minus.begin(), minus.end(), std::back_inserter( kept ) );
+      entry.clear();
+      std::merge( kept.begin(), kept.end(), plus.begin(), plus.end(), std::back_inserter( entry ) );
+      fence.clear();
+      for( size_t i = 0; i < entry.size(); i += FANOUT ) fence.push_back( entry[i].val );
+    }
+
+    size_t lower( T val ) const {
+                                                                                                                              /*
+      Position of the first entry with value >= `val`: fence pointers narrow search to one block:
+                                                                                                                              */
+      const size_t b{ size_t( std::lower_bound( fence.begin(), fence.end(), val ) - fence.begin() ) };
+      const size_t from{ b ? ( b - 1 )*FANOUT : 0 };
+      const size_t to  { std::min( b*FANOUT + 1, entry.size() ) };
+      return size_t( std::lower_bound( entry.begin() + from, entry.begin() + to, val,
+        []( const Entry& e, T v ){ return e.val < v; } ) - entry.begin() );
+    }
+
+  public:
+
+    Range(): entry{}, fence{}, added{}, removed{}{}
+                                                                                                                              /*
+    Value of the object changed from `*old` to `*val` (nullptr if none):
+                                                                                                                              */
+    void change( Identity obj, const T* old, const T* val ){
+      if( old and valid( *old ) ) removed.push_back( Entry{ *old, obj } );
+      if( val and valid( *val ) ) added  .push_back( Entry{ *val, obj } );
+    }
+
+    void clear(){ entry.clear(); fence.clear(); added.clear(); removed.clear(); }
+
+    size_t size(){ merge(); return entry.size(); }
+
+    template< typename F > size_t select( T lo, T hi, F f ){
+                                                                                                                              /*
+      Call `f( obj, val )` for each object with value in [lo, hi] in ascending order of values:
+                                                                                                                              */
+      merge();
+      size_t n{ 0 };
+      for( size_t i = lower( lo ); i < entry.size() and not ( hi < entry[i].val ); i++, n++ ) f( entry[i].obj, entry[i].val );
+      return n;
+    }
+
+    std::vector< Identity > select( T lo, T hi ){
+                                                                                                                              /*
+      Objects with value in [lo, hi] sorted by ID (ready for intersection with other sets):
+                                                                                                                              */
+      std::vector< Identity > R;
+      select( lo, hi, [&]( Identity obj, T ){ R.push_back( obj ); } );
+      std::sort( R.begin(), R.end() );
+      return R;
+    }
+
+  };//class Range
+
+}//namespace CoreAGI::Data
+
+#endif // DATA_RANGE_H_INCLUDED
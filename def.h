@@ -6,21 +6,30 @@
 
    2021.06.06 decombine(.) function added and combination(..) rewritten
 
+   2026.10.19 combination(..) / decombine(.) use BMI2 PDEP/PEXT (selected at runtime) or
+              magic-number bit spreading instead of 32-iteration loop; batch versions added
+
 ________________________________________________________________________________________________________________________________
                                                                                                                               */
 #ifndef DEF_H_INCLUDED
 #define DEF_H_INCLUDED
 
+#include <cassert>                                                                                             // [+] 2026.10.19
 #include <cmath>   // :nan()
 
 #include <bitset>
 #include <compare>
 #include <limits>
+#include <span>                                                                                                // [+] 2026.10.19
 #include <string>
 #include <tuple>
 
 #include "color.h"
 
+#if defined( __x86_64__ ) and defined( __GNUC__ )                                                              // [+] 2026.10.19
+  #include <immintrin.h> // :_pdep_u64, _pext_u64
+#endif
+
 namespace CoreAGI {
 
   using Identity = uint32_t; // :unsigned integer that keeps entity ID
@@ -29,42 +38,94 @@ namespace CoreAGI {
   constexpr const Identity    NIHIL { 0  };  // :identity of nonexistent quasi-entity
             const std::string NIL   { "" };  // :empty string
 
-  Key combination( const Identity& obj, const Identity& atr ){ //                                                 [+] 2021.06.06
-    constexpr size_t LEN{ 8*sizeof( Identity ) };
-    Identity src{ 0x1 }; // :refer obj and atr bit
-    Key      out{ 0x1 }; // :refet key bit
-    Key      key{   0 };
+  static_assert( sizeof( Key ) == 2*sizeof( Identity ) );
                                                                                                                               /*
-    Key`s bites processed from low to high, obj befor atr:
+  Key is Morton (bit-interleaved) combination of object ID and attribute ID: bit `i` of the
+  object is bit `2i` of the key, bit `i` of the attribute is bit `2i+1`. Interleaving done
+  by BMI2 PDEP/PEXT when CPU supports them (checked once at startup), otherwise by spreading
+  bits with magic masks (5 shift-and-mask steps instead of 32-iteration loop):
                                                                                                                               */
-    for( size_t i = 0; i < LEN; i++ ){ // Loop over obj and atr bits:
-      if( src & obj ){ key |= out; } out <<= 1; // :move to next key bit
-      if( src & atr ){ key |= out; } out <<= 1; // :move to next key bit
-      src <<= 1;    // :move to next bit of obj and atr
+  namespace Morton {                                                                                           // [+] 2026.10.19
+
+    constexpr Key EVEN{ 0x5555555555555555 }; // :bits of the object
+    constexpr Key ODD { 0xAAAAAAAAAAAAAAAA }; // :bits of the attribute
+
+    constexpr Key spread( Identity i ){ // :bit `k` moved to bit `2k`
+      Key x{ i };
+      x = ( x | ( x << 16 ) ) & 0x0000FFFF0000FFFF;
+      x = ( x | ( x <<  8 ) ) & 0x00FF00FF00FF00FF;
+      x = ( x | ( x <<  4 ) ) & 0x0F0F0F0F0F0F0F0F;
+      x = ( x | ( x <<  2 ) ) & 0x3333333333333333;
+      x = ( x | ( x <<  1 ) ) & 0x5555555555555555;
+      return x;
+    }
+
+    constexpr Identity squeeze( Key x ){ // :bit `2k` moved to bit `k`, odd bits ignored
+      x &= 0x5555555555555555;
+      x = ( x | ( x >>  1 ) ) & 0x3333333333333333;
+      x = ( x | ( x >>  2 ) ) & 0x0F0F0F0F0F0F0F0F;
+      x = ( x | ( x >>  4 ) ) & 0x00FF00FF00FF00FF;
+      x = ( x | ( x >>  8 ) ) & 0x0000FFFF0000FFFF;
+      x = ( x | ( x >> 16 ) ) & 0x00000000FFFFFFFF;
+      return Identity( x );
+    }
+
+#if defined( __x86_64__ ) and defined( __GNUC__ )
+
+    __attribute__(( target( "bmi2" ) )) inline Key      deposit( Identity obj, Identity atr ){ return _pdep_u64( obj, EVEN ) | _pdep_u64( atr, ODD ); }
+    __attribute__(( target( "bmi2" ) )) inline Identity extract( Key key, Key mask           ){ return Identity( _pext_u64( key, mask ) ); }
+
+    __attribute__(( target( "bmi2" ) )) inline void deposit( std::span< const Identity > obj, std::span< const Identity > atr, std::span< Key > key ){
+      for( size_t i = 0; i < key.size(); i++ ) key[i] = _pdep_u64( obj[i], EVEN ) | _pdep_u64( atr[i], ODD );
     }
-    return key;
+
+    __attribute__(( target( "bmi2" ) )) inline void extract( std::span< const Key > key, std::span< Identity > obj, std::span< Identity > atr ){
+      for( size_t i = 0; i < key.size(); i++ ){ obj[i] = Identity( _pext_u64( key[i], EVEN ) ); atr[i] = Identity( _pext_u64( key[i], ODD ) ); }
+    }
+
+    inline const bool BMI2{ __builtin_cpu_supports( "bmi2" ) != 0 };
+
+#else
+
+    inline Key      deposit( Identity, Identity ){ return 0; }
+    inline Identity extract( Key,      Key      ){ return 0; }
+    inline void     deposit( std::span< const Identity >, std::span< const Identity >, std::span< Key > ){}
+    inline void     extract( std::span< const Key >, std::span< Identity >, std::span< Identity > ){}
+
+    constexpr bool BMI2{ false };
+
+#endif
+
+  }//namespace Morton
+
+  Key combination( const Identity& obj, const Identity& atr ){ //                                                 [m] 2026.10.19
+    if( Morton::BMI2 ) return Morton::deposit( obj, atr );
+    return Morton::spread( obj ) | ( Morton::spread( atr ) << 1 );
   }//combination
 
-  std::tuple< Identity, Identity > decombine( const Key& KEY ){                                                // [+] 2021.06.06
-    constexpr size_t LEN{ 8*sizeof( Identity ) };
-    Identity obj { 0   };
-    Identity atr { 0   };
-    Key      key { KEY };
-    Key      src { 0x1 }; // :refer key bit
-    Identity out { 0x1 }; // :refer obj and attr bit
+  std::tuple< Identity, Identity > decombine( const Key& key ){                                                // [m] 2026.10.19
+    if( Morton::BMI2 ) return std::make_tuple( Morton::extract( key, Morton::EVEN ), Morton::extract( key, Morton::ODD ) );
+    return std::make_tuple( Morton::squeeze( key ), Morton::squeeze( key >> 1 ) );
+  }
                                                                                                                               /*
-    Key`s bites processed from low to high, obj befor atr:
+  Object or attribute only:
                                                                                                                               */
-    for( size_t i = 0; i < LEN; i++ ){ // Loop over obj and atr bits:
-      if( key & src ){ obj |= out; } src <<= 1;
-      if( key & src ){ atr |= out; } src <<= 1;
-      out <<= 1;
-    }
-    // assert( combination( obj, atr ) == KEY ); // DEBUG
-    return std::make_tuple( obj, atr );
+  Identity objectOf   ( const Key& key ){ return Morton::BMI2 ? Morton::extract( key, Morton::EVEN ) : Morton::squeeze( key      ); } // [+] 2026.10.19
+  Identity attributeOf( const Key& key ){ return Morton::BMI2 ? Morton::extract( key, Morton::ODD  ) : Morton::squeeze( key >> 1 ); } // [+] 2026.10.19
+                                                                                                                              /*
+  Batch versions; all spans have the same size:
+                                                                                                                              */
+  void combination( std::span< const Identity > obj, std::span< const Identity > atr, std::span< Key > key ){ // [+] 2026.10.19
+    assert( obj.size() == key.size() and atr.size() == key.size() );
+    if( Morton::BMI2 ){ Morton::deposit( obj, atr, key ); return; }
+    for( size_t i = 0; i < key.size(); i++ ) key[i] = Morton::spread( obj[i] ) | ( Morton::spread( atr[i] ) << 1 );
   }
 
-  static_assert( sizeof( Key ) == 2*sizeof( Identity ) );
+  void decombine( std::span< const Key > key, std::span< Identity > obj, std::span< Identity > atr ){          // [+] 2026.10.19
+    assert( obj.size() == key.size() and atr.size() == key.size() );
+    if( Morton::BMI2 ){ Morton::extract( key, obj, atr ); return; }
+    for( size_t i = 0; i < key.size(); i++ ){ obj[i] = Morton::squeeze( key[i] ); atr[i] = Morton::squeeze( key[i] >> 1 ); }
+  }
 
   auto kit = []( auto... parameters )->std::string{
     constexpr unsigned CAPACITY{ 2046 };
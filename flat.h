@@ -13,6 +13,18 @@
 
 
   2020.12.03
+
+  2026.10.19 `Map` storage splitted into lazily allocated copy-on-write pages;
+             read-only part moved into `MapView`; added `Map.freeze()` that
+             makes immutable image of the map sharing pages with it;
+             page ownership tracked by generations instead of reference counts: page
+             is private while made in the current generation of the map, `freeze()`
+             starts new generation; non-const lookup never copies page, writable
+             access to the value via `Map.mod(..)`;
+             `Set` iteration stops after last element
+             Added `Map.adopt( view )` that sets content of the frozen image;
+             added `Map.adopt(..)` that sets pages made elsewhere (e.g. mapped from file);
+             `Map.adopt(..)` can replace a few listed pages only
 ________________________________________________________________________________________________________________________________
                                                                                                                               */
 #ifndef FLAT_H_INCLUDED
@@ -20,8 +32,12 @@ ________________________________________________________________________________
 
 #include <cassert>
 #include <cstdint>
+#include <cstdlib>      // calloc, free
 #include <cstring>
 
+#include <algorithm>                                                                                           // [+] 2026.10.19
+#include <atomic>                                                                                              // [+] 2026.10.19
+#include <memory>       // std::shared_ptr
 #include <utility>      // std::move
 #include <vector>
 #include <span>
@@ -272,23 +288,26 @@ namespace CoreAGI::Flat {
     struct Sentinel{};
 
     struct Iter {
-
+                                                                                                                              /*
+      Iteration stops after last element visited, so rest of the cells is not scanned:
+                                                                                                                              */
       const Set& S;
       unsigned i;
+      unsigned left; // :number of elements not visited yet                                                    // [+] 2026.10.19
 
-      Iter( const Set& X ): S{ X }, i{ 0 }{
-        if( S.data[i].key == NIHIL or S.data[i].del ) ++(*this);
+      void seek(){ while( i < SPACE and ( S.data[i].key == NIHIL or S.data[i].del ) ) i++; }                   // [+] 2026.10.19
+
+      Iter( const Set& X ): S{ X }, i{ 0 }, left{ X.cardinal }{                                                // [m] 2026.10.19
+        if( left == 0 ) i = SPACE; else seek();
       }
 
       bool operator != ( [[maybe_unused]]const Sentinel& S ) const { return i < SPACE; }
 
-      Iter& operator++ (){
-        for(;;){
-          i++;
-          if( i >= SPACE                              ) return *this;
-          if( S.data[i].key == NIHIL or S.data[i].del ) continue;
-          return *this;
-        }
+      Iter& operator++ (){                                                                                     // [m] 2026.10.19
+        if( --left == 0 ){ i = SPACE; return *this; }
+        i++;
+        seek();
+        return *this;
       }
 
       Elem operator* (){ return S.data[i].key; }
@@ -313,9 +332,22 @@ namespace CoreAGI::Flat {
   ______________________________________________________________________________________________________________________________
                                                                                                                               */
 
-  template< typename Val, unsigned CAPACITY, unsigned LOAD_FACTOR_PERCENT = 80 > class Map {
+  template< typename Val, unsigned CAPACITY, unsigned LOAD_FACTOR_PERCENT = 80 > class MapView {                // [+] 2026.10.19
+                                                                                                                              /*
+    Read-only part of the `Map`.
 
-    static constexpr unsigned SPACE = CAPACITY*100/LOAD_FACTOR_PERCENT;
+    Storage of the map splitted into pages of PAGE entries each; page allocated
+    when first written, so absent page means page of vacant cells. Pages are
+    reference-counted and can be shared between a few views; `Map` copies shared
+    page before modification (copy-on-write; see `Map.mut(..)`). So copy of the view is an immutable
+    image of the map at the moment of copying that costs PAGES pointers only:
+                                                                                                                              */
+  protected:
+
+    static constexpr unsigned SPACE    { CAPACITY*100/LOAD_FACTOR_PERCENT };
+    static constexpr unsigned PAGE_BITS{ 7                                }; // :128 entries per page
+    static constexpr unsigned PAGE     { 1 << PAGE_BITS                   };
+    static constexpr unsigned PAGES    { ( SPACE + PAGE - 1 )/PAGE        };
 
     static_assert( std::is_trivially_copyable< Key >::value );
     static_assert( std::is_trivially_copyable< Val >::value );
@@ -329,6 +361,156 @@ namespace CoreAGI::Flat {
       Val     val;
     };
 
+    using Page = std::shared_ptr< Entry[] >;
+
+  protected:
+
+	  uint32_t cardinal;
+	  uint64_t revision;          // :incremented on each modification
+	  Page     page[ PAGES ];
+
+    const Entry& at( unsigned i ) const {
+      static const Entry VACANT{};
+      const Page& P{ page[ i >> PAGE_BITS ] };
+      return P ? P[ i & ( PAGE - 1 ) ] : VACANT;
+    }
+
+    int find( const Key key ) const {
+                                                                                                                              /*
+      Returns position of the `key` (maybe deleted) or -1 if not found:
+                                                                                                                              */
+	    if( cardinal == 0  ) return -1;
+      unsigned i{ key % SPACE }; // :desired position
+	    while( at( i ).key != key ){
+		    i = ( i + 1 ) % SPACE;
+		    if( i == key % SPACE ) return -1;	// :full loop performed but not found
+      }
+      assert( i < SPACE );
+      return int( i );
+    }
+
+  public:
+
+    MapView(): cardinal{ 0 }, revision{ 0 }, page{}{}
+
+    const Val* get( const Key key ) const {
+	    assert( key < UINT24 );
+      const int i{ find( key ) };
+      if( i < 0 ) return nullptr;
+                                                                                                                              /*
+      Key found, but it may be deleted, so result depends on date[.].del:
+                                                                                                                              */
+      const Entry& e{ at( i ) };
+	    return e.del ? nullptr : &( e.val );
+    }
+
+    bool contains( const Elem elem ) const {
+	    assert( elem < UINT24 );
+      if( elem == NIHIL  ) return false;
+      const int i{ find( elem ) };
+	    return i >= 0 and not at( i ).del;
+    }
+
+	  explicit operator bool() const{ return cardinal > 0; }
+
+    const Val* operator[] ( const Key e ) const { return get( e ); }
+
+	  unsigned size   () const { return cardinal;      }
+	  bool     empty  () const { return cardinal == 0; }
+	  uint64_t version() const { return revision;      }
+
+    unsigned pages() const {
+                                                                                                                              /*
+      Number of allocated pages:
+                                                                                                                              */
+      unsigned n{ 0 };
+      for( const auto& P: page ) if( P ) n++;
+      return n;
+    }
+                                                                                                                              /*
+    Raw access to the pages, used to save the map verbatim (see `Map.adopt(..)`):
+                                                                                                                              */
+    static constexpr unsigned pageCapacity(){ return PAGE;  } // :entries per page                             // [+] 2026.10.19
+    static constexpr unsigned pageCount   (){ return PAGES; } // :pages per map                                // [+] 2026.10.19
+
+    const Entry* pageData( unsigned p ) const { return page[p].get(); } // :nullptr for absent page            // [+] 2026.10.19
+
+    struct Sentinel{};
+
+    struct Iter {
+
+      const MapView& S;
+      unsigned       i;
+
+      Iter( const MapView& X ): S{ X }, i{ 0 }{
+        if( S.at( i ).key == NIHIL or S.at( i ).del ) ++(*this);
+      }
+
+      bool operator != ( const Sentinel& ) const { return i < SPACE; }
+
+      Iter& operator++ (){
+        for(;;){
+          i++;
+          if( i >= SPACE ) return *this;
+          if( not S.page[ i >> PAGE_BITS ] ){ i |= PAGE - 1; continue; } // :skip absent page
+          const Entry& e{ S.at( i ) };
+          if( e.key == NIHIL or e.del ) continue;
+          return *this;
+        }
+      }
+
+      const Entry& operator* (){ return S.at( i ); }
+
+    };//struct Iter
+
+    auto begin() const { return Iter( *this ); }
+    auto end  () const { return Sentinel();    }
+
+	  double averageProbeCount() const {
+	    unsigned num{ 0   };
+		  double   sum{ 0.0 };
+		  for( unsigned i = 0; i < SPACE; ++i ){
+			  unsigned dib = at( i ).dib;
+		  	if( dib > 0 ){ num++, sum += dib;	}
+	  	}
+		  return num ? sum/num : 0.0;
+	  }
+
+  };//class MapView
+                                                                                                                              /*
+  ______________________________________________________________________________________________________________________________
+                                                                                                                              */
+
+  template< typename Val, unsigned CAPACITY, unsigned LOAD_FACTOR_PERCENT = 80 >
+  class Map: public MapView< Val, CAPACITY, LOAD_FACTOR_PERCENT > {                                            // [m] 2026.10.19
+
+  public:
+
+    using View  = MapView< Val, CAPACITY, LOAD_FACTOR_PERCENT >;                                               // [+] 2026.10.19
+    using Entry = typename View::Entry;
+    using Page  = typename View::Page;
+
+  private:
+
+    using View::SPACE;
+    using View::PAGE_BITS;
+    using View::PAGE;
+    using View::PAGES;                                                                                         // [+] 2026.10.19
+    using View::cardinal;
+    using View::revision;
+    using View::page;
+    using View::at;
+    using View::find;
+                                                                                                                              /*
+    Page is private for the map if it was made by the map in the current generation; `freeze()`
+    starts new generation, so all pages become shared. Reference count of the page can not be used
+    for that: it changes concurrently when view released by other thread:
+                                                                                                                              */
+    mutable std::atomic< uint64_t > epoch;           // :current generation                                    // [+] 2026.10.19
+    uint64_t                        owner[ PAGES ];  // :generation in which the page was made by the map      // [+] 2026.10.19
+
+  public:
+
     enum Note: int8_t {
                                                                                                                               /*
       Explanation about incl/excl operation;
@@ -357,13 +539,36 @@ namespace CoreAGI::Flat {
       return nullptr;
     }
 
-    static unsigned capacity(){ return CAPACITY;                                                      }
-    static unsigned memory  (){ return sizeof( Entry )*SPACE + sizeof( cardinal ) + sizeof( Entry* ); }
+    static unsigned capacity(){ return CAPACITY;                                }
+    static unsigned space   (){ return SPACE;                                   } // :number of cells          // [+] 2026.10.19
+    static unsigned memory  (){ return sizeof( Entry )*SPACE + sizeof( View );  } // :all pages allocated       // [m] 2026.10.19
 
   private:
 
-	  uint32_t cardinal;
-	  Entry*   data;
+    static Page blank(){                                                                                       // [+] 2026.10.19
+                                                                                                                              /*
+      Zero-filled page; entries are trivially copyable and zero bytes means vacant entry:
+                                                                                                                              */
+      Page P{ static_cast< Entry* >( calloc( PAGE, sizeof( Entry ) ) ), free };
+      assert( P );
+      return P;
+    }
+
+    Entry& mut( unsigned i ){                                                                                  // [+] 2026.10.19
+                                                                                                                              /*
+      Writable access to the cell: allocate absent page or copy page shared with some view:
+                                                                                                                              */
+      const unsigned p{ i >> PAGE_BITS };
+      Page&          P{ page[p] };
+      if( not P or owner[p] != epoch.load( std::memory_order_acquire ) ){                                      // [m] 2026.10.19
+        Page C{ blank() };
+        if( P ) memcpy( C.get(), P.get(), sizeof( Entry )*PAGE );
+        P        = C;
+        owner[p] = epoch.load( std::memory_order_relaxed );
+      }
+      revision++;
+      return P[ i & ( PAGE - 1 ) ];
+    }
 
 	  Note incl_( Key key, const Val& val, unsigned depth = 0 ){
       assert( key != NIHIL );
@@ -372,28 +577,30 @@ namespace CoreAGI::Flat {
       unsigned i{ key % SPACE        }; // :desired position
       Entry    e{ key, 0, false, val }; // :DIB (distance to initial bucket) is zero initially
       for( unsigned c = i; ; c = ( c + 1 ) % SPACE ){
-		    if( data[c].key == 0 ){ // Vacant cell, insert here
-			    data[c] = e;
+        const Entry& C{ at( c ) };                                                                             // [+] 2026.10.19
+		    if( C.key == 0 ){ // Vacant cell, insert here
+			    mut( c ) = e;
 			    cardinal++;
 			    return INCLUDED;
 		    }
-		    if( data[c].key == e.key ){ // Presented or deleted
-			    if( data[c].del ){ // Sometime was presented but deleted - just recovery:
-			      data[c].del = false;
-			      data[c].val = e.val;
+		    if( C.key == e.key ){ // Presented or deleted
+		      Entry& M{ mut( c ) };
+			    if( M.del ){ // Sometime was presented but deleted - just recovery:
+			      M.del = false;
+			      M.val = e.val;
 			      cardinal++;
 			      return RECOVERED;
 			    } else { // Presented:
-			      data[c].val = e.val;
+			      M.val = e.val;
 			      return CONTAINED;
 			    }
 			    break;
 		    }
-			  if( data[c].dib < e.dib ){ // To be swapped because it is rich.
-			                                                                                                                        /*
+			  if( C.dib < e.dib ){ // To be swapped because it is rich.
+                                                                                                                              /*
 			    Swap `e` and `data[c]`, i.e. insert here but move current element to some another place
-			                                                                                                                        */
-          std::swap( e, data[c] );
+                                                                                                                              */
+          std::swap( e, mut( c ) );
         }//if
         constexpr unsigned DIB_LIMIT{ 8 }; // :rehashing criterion
         if( e.dib >= DIB_LIMIT ){ return rehash( e, depth ); }
@@ -408,7 +615,7 @@ namespace CoreAGI::Flat {
                                                                                                                               */
       std::vector< Entry > E( cardinal );
       unsigned n{ 0 };
-      for( unsigned i = 0; i < SPACE; i++ ) if( data[i].key != 0 and not data[i].del ) E[n++] = data[i];
+      for( const auto& entry: *this ) E[n++] = entry;
       clear();
       for( unsigned i = 0; i < n; i++ ) assert( incl_( E[i].key, E[i].val, depth + 1 ) );
                                                                                                                               /*
@@ -424,7 +631,7 @@ namespace CoreAGI::Flat {
 	    std::stringstream out;
 	    out << std::setw( 4 ) << cardinal << " {";
 	    for( unsigned i = 0; i < SPACE; i++ ){
-	      Entry& e{ data[i] };
+	      const Entry& e{ at( i ) };
 	      if( e.key == 0 ) out << "  empty ";
 	      else {
 	        if( e.del ) out << " ("; else out << "  ";
@@ -439,18 +646,55 @@ namespace CoreAGI::Flat {
 
     void clear(){
       cardinal = 0;
-	    memset( data, 0, sizeof( Entry )*SPACE );
+      for( auto& P: page ) P.reset(); // :pages shared with views stay alive there                             // [m] 2026.10.19
+      revision++;
     }
 
-	  Map(): cardinal{ 0 }, data{ new Entry[ SPACE ] }{
-	    assert( data );
-	    memset( data, 0, sizeof( Entry )*SPACE );
-	  }
+	  Map(): View{}, epoch{ 1 }, owner{}{}                                                                        // [m] 2026.10.19
 
 	  Map( const Map& ) = delete;
 	  Map& operator = ( const Map& ) = delete;
-
-	 ~Map(){ delete[] data; }
+                                                                                                                              /*
+    Immutable image of the current state (see `MapView`):
+                                                                                                                              */
+    View freeze() const {                                                                                      // [+] 2026.10.19
+      epoch.fetch_add( 1, std::memory_order_acq_rel ); // :all pages become shared
+      return View( *this );
+    }
+                                                                                                                              /*
+    Replace content by frozen image (see `freeze()`); pages stay shared with the image:
+                                                                                                                              */
+    void adopt( const View& V ){                                                                               // [+] 2026.10.19
+      const uint64_t r{ revision };
+      View::operator = ( V );
+      for( auto& o: owner ) o = 0; // :copied when written
+      revision = std::max( r, V.version() ) + 1;
+    }
+                                                                                                                              /*
+    Replace content by pages made elsewhere (for example mapped from file saved
+    verbatim); pages are never modified in place while shared, so memory that
+    backs them must stay alive while any page refers it (use aliasing constructor
+    of std::shared_ptr):
+                                                                                                                              */
+    void adopt( std::span< const Page > pages, uint32_t cardinality ){                                         // [+] 2026.10.19
+      assert( pages.size() == PAGES );
+      for( unsigned p = 0; p < PAGES; p++ ){ page[p] = pages[p]; owner[p] = 0; } // :copied when written
+      cardinal = cardinality;
+      revision++;
+    }
+                                                                                                                              /*
+    Replace listed pages only (see above); `index[i]` is number of the page replaced by `pages[i]`:
+                                                                                                                              */
+    void adopt( std::span< const unsigned > index, std::span< const Page > pages, uint32_t cardinality ){      // [+] 2026.10.19
+      assert( index.size() == pages.size() );
+      for( size_t i = 0; i < index.size(); i++ ){                                                               // [m] 2026.10.19
+        assert( index[i] < PAGES );
+        page [ index[i] ] = pages[i];
+        owner[ index[i] ] = 0; // :copied when written
+      }
+      cardinal = cardinality;
+      revision++;
+    }
 
     bool vacant( Key key, unsigned maxDistance = 0 ) const {
       assert( key != NIHIL );
@@ -459,7 +703,7 @@ namespace CoreAGI::Flat {
       const unsigned desiredPosition{ key % SPACE }; // :desired position
       unsigned distance{ 0 };
       unsigned i{ desiredPosition };
-	    while( not( data[i].key == NIHIL or data[i].del ) ){
+	    while( not( at( i ).key == NIHIL or at( i ).del ) ){
 		    i = ( i + 1 ) % SPACE;
 		    if( ++distance > maxDistance ) return false; // :too distant
 		    if( i == desiredPosition     ) return false; // :no vacant found in full loop
@@ -469,120 +713,37 @@ namespace CoreAGI::Flat {
 
 	  Note incl( Key elem, const Val& val = Val{} ){ return incl_( elem, val ); }
 
-    Val* get( const Key key ){
-	    assert( key < UINT24 );
-	    if( cardinal == 0  ) return nullptr;
-      unsigned i{ key % SPACE }; // :desired position
-	    while( data[i].key != key ){
-		    i = ( i + 1 ) % SPACE;
-		    if( i == key % SPACE ) return nullptr;	// :full loop performed but not found
-      }
-      assert( i < SPACE );
-                                                                                                                              /*
-      Key found, but it may be deleted, so result depends on date[.].del:
-                                                                                                                              */
-	    return data[i].del ? nullptr : &( data[i].val );
-    }
+    using View::get;
 
-    const Val* get( const Key key ) const {
+    Val* mod( const Key key ){                                                                                 // [+] 2026.10.19
 	    assert( key < UINT24 );
-	    if( cardinal == 0  ) return nullptr;
-      unsigned i{ key % SPACE }; // :desired position
-	    while( data[i].key != key ){
-		    i = ( i + 1 ) % SPACE;
-		    if( i == key % SPACE ) return nullptr;	// :full loop performed but not found
-      }
-      assert( i < SPACE );
+      const int i{ find( key ) };
+      if( i < 0 or at( i ).del ) return nullptr;
                                                                                                                               /*
-      Key found, but it may be deleted, so result depends on date[.].del:
+      Writable access to the value; page shared with some view copied (lookup goes via
+      const `get(..)` that never copies page):
                                                                                                                               */
-	    return data[i].del ? nullptr : &( data[i].val );
-    }
-
-    bool contains( const Elem elem ) const {
-	    assert( elem < UINT24 );
-//    assert( elem != NIHIL );                                                                                 // [-] 2021.04.27
-      if( elem == NIHIL  ) return false;                                                                       // [+] 2021.04.27
-	    if( cardinal == 0  ) return false;
-      unsigned i{ elem % SPACE };
-	    while( data[i].key != elem ){
-		    i = ( i + 1 ) % SPACE;
-		    if( i == elem % SPACE ) return false;	// :not Found, vacant call reached
-      }
-                                                                                                                              /*
-      Key found, but it may be deleted, so result depends on date[.].del:
-                                                                                                                              */
-	    return not data[i].del;
+	    return &( mut( i ).val );
     }
 
     Note excl( const Key elem ){
 	    assert( elem < UINT24 );
 	    if( elem == NIHIL ) return NOT_FOUND;
 	    if( cardinal == 0 ) return EMPTY_SET;
-      unsigned i{ elem % SPACE };
-	    while( data[i].key != elem ){
-		    i = ( i + 1 ) % SPACE;
-		    if( i == elem % SPACE ){
-		      return NOT_FOUND;	// :not Found
-		    }
-      }
+      const int i{ find( elem ) };                                                                             // [m] 2026.10.19
+      if( i < 0 ) return NOT_FOUND;	// :not Found
                                                                                                                               /*
       Key found, mark it as deleted:
                                                                                                                               */
-      if( not data[i].del ){
-        data[i].del = true;
+      if( not at( i ).del ){
+        mut( i ).del = true;
         cardinal--;
         return EXCLUDED;
       }
       return NOT_FOUND; // :the item has already been deleted earlier
     }
 
-	  explicit operator bool() const{ return cardinal > 0; }
-
-    const Val* operator[] ( const Key e ) const { return get( e ); }
-          Val* operator[] ( const Key e )       { return get( e ); }
-
-	  unsigned size () const { return cardinal;      }
-	  bool     empty() const { return cardinal == 0; }
-
-    struct Sentinel{};
-
-    struct Iter {
-
-      const Map& S;
-      unsigned   i;
-
-      Iter( const Map& X ): S{ X }, i{ 0 }{
-        if( S.data[i].key == NIHIL or S.data[i].del ) ++(*this);
-      }
-
-      bool operator != ( const Sentinel& ) const { return i < SPACE; }
-
-      Iter& operator++ (){
-        for(;;){
-          i++;
-          if( i >= SPACE                              ) return *this;
-          if( S.data[i].key == NIHIL or S.data[i].del ) continue;
-          return *this;
-        }
-      }
-
-      const Entry& operator* (){ return S.data[i]; }
-
-    };//struct Iter
-
-    auto begin() const { return Iter( *this ); }
-    auto end  () const { return Sentinel();    }
-
-	  double averageProbeCount() const {
-	    unsigned num{ 0   };
-		  double   sum{ 0.0 };
-		  for( unsigned i = 0; i < SPACE; ++i ){
-			  unsigned dib = data[i].dib;
-		  	if( dib > 0 ){ num++, sum += dib;	}
-	  	}
-		  return num ? sum/num : 0.0;
-	  }
+    const Val* operator[] ( const Key e ) const { return get( e ); }                                           // [m] 2026.10.19
 
   };//class Map
 
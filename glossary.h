@@ -17,26 +17,51 @@
 
   2021.06.13 Modified event processing
 
+  2026.10.19 Glossary file written and read via block-buffered `EncodedWriter` / `EncodedReader`
+
+  2026.10.19 Names kept once in the arena of `Names` (see `names.h`) instead of two maps of
+             std::string; name resolution via string_view without allocation
+
+  2026.10.19 Results of ref(..) and definition(..) cached; cache validated by versions of the graph,
+             data storage, names and external dictionary (see `dictChanged()`)
+
+  2026.10.19 Prefix search: complete(..) and common(..) over sorted index of `Names`
+
+  2026.10.19 Approximate lookup: similar(..) over trigram index of `Names`
+
+  2026.10.19 dump(..) formats frozen segments in parallel into memory buffers written by `fwrite`
+
+  2026.10.19 Binary image: image(..) / restore(..); load(..) recognizes image and restores it
+
+  2026.10.19 Binary image saved and restored together with the Gnosis image or checkpoint
+             (see `Gnosis.onPersistIncl(..)`) as `<title>.glossary.img`; serialize(..) makes image
+             in memory
+
 ________________________________________________________________________________________________________________________________
                                                                                                                               */
 #ifndef GLOSSARY_H_INCLUDED
 #define GLOSSARY_H_INCLUDED
 
+#include <unistd.h>        // :fsync
 #include <cstdio>
 
+#include <atomic>
 #include <filesystem>
 #include <functional>
 #include <ranges>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "ancillary.h"
 #include "config.h"
 #include "codec.h"
 #include "color.h"
+#include "crc.h"
 #include "flat_hash.h"
 #include "gnosis.h"
 #include "data.mini.h"
+#include "names.h"                                                                                             // [+] 2026.10.19
 
 namespace CoreAGI {
 
@@ -47,18 +72,84 @@ namespace CoreAGI {
   class Glossary: public Ancillary {
 
     Data::Storage&                                 data;
-    ska::flat_hash_map< Identity,    std::string > LEX;
-    ska::flat_hash_map< std::string, Identity    > IDENTITY;
+    Names                                          names;      // :ID <-> name                                 // [m] 2026.10.19
     Identity                                       onChangeId;
+    Identity                                       onPersist;  // :saved and restored with the graph image     // [+] 2026.10.19
+                                                                                                                              /*
+    Binary image: header followed by table of names (ID, offset, length) and blob of records
+    `length (4 bytes), chars, '\0'` adopted as the arena of `Names`:
+                                                                                                                              */
+    static constexpr char     IMAGE_MAGIC[ 8 ]{ 'G', 'e', 'l', 'G', 'L', 'O', '0', '1' };                      // [+] 2026.10.19
+    static constexpr uint32_t IMAGE_VERSION   { 1          };
+    static constexpr uint32_t IMAGE_ENDIAN    { 0x01020304 }; // :written in native byte order
+
+    struct ImageHeader {                                                                                       // [+] 2026.10.19
+      char     magic[ 8 ];
+      uint32_t version;
+      uint32_t endian;
+      uint64_t count;     // :number of names
+      uint64_t size;      // :bytes of the blob
+      uint32_t crc;       // :CRC-32 of the table and the blob
+      uint32_t reserved;
+    };
+
+    static_assert( sizeof( ImageHeader ) == 40 );
+    static_assert( sizeof( Names::Record ) == 12 );
+                                                                                                                              /*
+    Rendering cache: results of ref(..) and definition(..) keyed by entity ID, kind of rendering
+    and flags of `arg`; dropped as a whole when graph, data, names or dictionary changed:
+                                                                                                                              */
+    struct Stamp {                                                                                             // [+] 2026.10.19
+      uint64_t graph;
+      uint64_t data;
+      uint64_t names;
+      uint64_t dict;
+      bool operator == ( const Stamp& ) const = default;
+    };
+
+    enum Rendering: uint64_t { REF = 0, DEFINITION = 1 };                                                      // [+] 2026.10.19
+
+    mutable ska::flat_hash_map< uint64_t, std::string > rendered;                                              // [+] 2026.10.19
+    mutable Stamp                                       stamp;                                                 // [+] 2026.10.19
+    uint64_t                                            dictRevision;                                          // [+] 2026.10.19
+
+    static uint64_t renderKey( Identity id, Rendering kind, const char* arg, bool dict ){                      // [+] 2026.10.19
+      uint64_t k{ kind };
+      if( strchr( arg, 'c' ) ) k |= 0x02;
+      if( strchr( arg, 'v' ) ) k |= 0x04;
+      if( strchr( arg, '*' ) ) k |= 0x08;
+      if( dict               ) k |= 0x10;
+      return ( uint64_t( id ) << 8 ) | k;
+    }
+
+    const std::string* cached( uint64_t key ) const {                                                          // [+] 2026.10.19
+      const Stamp now{ gnosis.version(), data.version(), names.version(), dictRevision };
+      if( not ( now == stamp ) ){
+        rendered.clear();
+        stamp = now;
+        return nullptr;
+      }
+      const auto it{ rendered.find( key ) };
+      return it == rendered.end() ? nullptr : &it->second;
+    }
+
+    std::string remember( uint64_t key, std::string&& text ) const {                                           // [+] 2026.10.19
+      if( rendered.size() >= CAPACITY_OF_CACHE ) rendered.clear();
+      rendered.insert_or_assign( key, text );
+      return text;
+    }
 
   public:
 
     Glossary( const char* title, Logger& logger, Gnosis& gnosis, Data::Storage& data ):
       Ancillary { title, logger, gnosis },
       data      { data                  },
-      LEX       {                       },
-      IDENTITY  {                       },
-      onChangeId{                       }
+      names     {                       },                                                                     // [m] 2026.10.19
+      onChangeId{                       },
+      onPersist {                       },                                                                     // [+] 2026.10.19
+      rendered  {                       },                                                                     // [+] 2026.10.19
+      stamp     {                       },
+      dictRevision{ 0                   }
     {
                                                                                                                               /*
       Assign congenital entities names:
@@ -101,6 +192,7 @@ namespace CoreAGI {
       let( gnosis.RUN,       "RUN"        );
       let( gnosis.SEQ,       "SEQ"        );
       let( gnosis.SEQUENCE,  "SEQUENCE"   );
+      let( gnosis.SPAN,      "SPAN"       );  // [+] 2026.10.19
       let( gnosis.STRING,    "STRING"     );
       let( gnosis.SUM,       "SUM"        );
       let( gnosis.SWAP,      "SWAP"       );
@@ -116,39 +208,38 @@ namespace CoreAGI {
       Set onChangeId:
                                                                                                                               */
       onChangeId = gnosis.onChangeIdIncl(
-        [&]( const Identity& id, const Identity& id2, bool attribute )->void{ forget( id ); }
+        [&]( const Identity& id, const Identity& id2, bool attribute )->void{ forget( id ); rendered.clear(); } // [m] 2026.10.19
+      );
+      onPersist = gnosis.onPersistIncl( // :file named by title, so a few glossaries of the graph coexist      // [+] 2026.10.19
+        kit( "%s.%s", TITLE, Config::glossary::IMAGE ).c_str(),
+        [&]( std::vector< uint8_t >& out )->void{ serialize( out ); },
+        [&]( const char* path )->bool{ return restore( path ); }
       );
     }
 
     Glossary( const Glossary& ) = delete;
     Glossary& operator = ( const Glossary& ) = delete;
 
-   ~Glossary(){ gnosis.onChangeIdExcl( onChangeId ); }
+   ~Glossary(){                                                                                                // [m] 2026.10.19
+      gnosis.onChangeIdExcl( onChangeId );
+      gnosis.onPersistExcl ( onPersist  );
+    }
 
-    size_t size() const { return LEX.size(); }                                                                 // [+] 2020.07.30
+    size_t size() const { return names.size(); }                                                               // [+] 2020.07.30
 
-    bool forget( const Identity& id ){
-      // log.vital( kit( "[forget] ID %u ...", id ) ); log.flush();                                                // DEBUG
-      const auto it = LEX.find( id );
-      if( it == LEX.end() ){
-        // log.vital( kit( "[forget] not found", id ) ); log.flush();                                                // DEBUG
-        return false;
-      }
-      auto name = it->second;
-      IDENTITY.erase( name );
-      LEX     .erase( id   );
-      // log.vital( "[forget] [ok]" ); log.flush();                                                       // DEBUG
-      return true;
-    }
+    size_t bytes() const { return names.bytes(); } // :memory used by names                                   // [+] 2026.10.19
+
+    bool forget( const Identity& id ){ return names.forget( id ); }                                            // [m] 2026.10.19
+
+    void dictChanged(){ dictRevision++; } // :external dictionary passed to ref(..) etc. modified              // [+] 2026.10.19
 
-    Gnosis::Entity entity( const std::string& name ){
+    Gnosis::Entity entity( std::string_view name ){                                                            // [m] 2026.10.19
       if( name.empty() ) return gnosis.none();
                                                                                                                               /*
       Returns existing entity or creates new one:
                                                                                                                               */
-      const auto& it = IDENTITY.find( name );
-      if( it != IDENTITY.end() ){
-        const Identity id{ it->second };
+      const Identity id{ names.find( name ) };
+      if( id != CoreAGI::NIHIL ){
         assert( gnosis.exist( id ) );
         return gnosis.recover( id ); // :known entity identified by name
       }
@@ -160,11 +251,11 @@ namespace CoreAGI {
       return e;
     }
 
+    Gnosis::Entity entity( const std::string& name ){ return entity( std::string_view( name ) ); }             // [m] 2026.10.19
+
     Gnosis::Entity entity( const char* name ){                                                           // [+] 2020.07.30
       if( not name ) return gnosis.none();
-      const std::string NAME{ name };
-      if( NAME.empty() ) return gnosis.none();
-      return entity( NAME );
+      return entity( std::string_view( name ) );                                                               // [m] 2026.10.19
     }
 
     Gnosis::Entity entity( const std::string& name, std::initializer_list< Gnosis::Entity > syndrome ){
@@ -182,21 +273,44 @@ namespace CoreAGI {
     Gnosis::Entity operator() ( const std::string& name ){ return entity( name ); }                            // [+] 2020.11.08
     Gnosis::Entity operator() ( const char*        name ){ return entity( name ); }                            // [+] 2020.11.08
 
-    Gnosis::Entity known( const std::string& name ) const {
+    Gnosis::Entity known( std::string_view name ) const {                                                      // [m] 2026.10.19
       if( name.empty() ) return gnosis.none();                                                          // [+] 2020.07.30
                                                                                                                               /*
       Returns existing entity or NIHIL`id one:
                                                                                                                               */
-      const auto& it = IDENTITY.find( name );
-      if( it == IDENTITY.end() ) return gnosis.none();
-      const Identity id{ it->second };                 assert( id != CoreAGI::NIHIL );
+      const Identity id{ names.find( name ) };
+      if( id == CoreAGI::NIHIL ) return gnosis.none();
       return gnosis.recover( id );
     }
 
+    Gnosis::Entity known( const std::string& name ) const { return known( std::string_view( name ) ); }        // [m] 2026.10.19
+
     Gnosis::Entity known( const char* name ) const {
       if( not name ) return gnosis.none();
-      const std::string NAME{ name };
-      return known( NAME );
+      return known( std::string_view( name ) );                                                                // [m] 2026.10.19
+    }
+
+    std::vector< std::string > complete( std::string_view prefix, unsigned limit = COMPLETION_LIMIT ) const {  // [+] 2026.10.19
+                                                                                                                              /*
+      Up to `limit` names that start with `prefix` in alphabetical order:
+                                                                                                                              */
+      std::vector< std::string > R;
+      names.complete( prefix, limit, [&]( Identity, std::string_view name ){ R.emplace_back( name ); } );
+      return R;
+    }
+
+    std::string common( std::string_view prefix ) const { return std::string( names.common( prefix ) ); }     // [+] 2026.10.19
+
+    std::vector< std::string > similar( std::string_view name,                                                 // [+] 2026.10.19
+                                        unsigned         distance = SIMILARITY_DISTANCE,
+                                        unsigned         limit    = SIMILARITY_LIMIT ) const {
+                                                                                                                              /*
+      Up to `limit` names within edit distance `distance` of `name`, nearest first; distance
+      limited by third of the length of the name (short names with more typos are other names):
+                                                                                                                              */
+      std::vector< std::string > R;
+      names.similar( name, std::min< unsigned >( distance, unsigned( name.size()/3 ) ), limit, [&]( Identity, std::string_view lex, unsigned ){ R.emplace_back( lex ); } );
+      return R;
     }
 
     std::string key( const Gnosis::Entity& e, const char* arg = " " ) const {
@@ -210,16 +324,16 @@ namespace CoreAGI {
     std::string lex( const Gnosis::Entity& entity, const char* arg = " ", Dict dict = nullptr ) const {
       log.sure( gnosis.ID == entity.unit, kit( "Alien entity, gnosis`ID:%u, entity.unit: %u", gnosis.ID, entity.unit ) );
       const bool decorated = strchr( arg, 'c' );
-      const auto& it = LEX.find( entity.id );
-      if( it == LEX.end() ){
+      const std::string_view name{ names.lex( entity.id ) };                                                   // [m] 2026.10.19
+      if( name.empty() ){
         if( strchr( arg, 'v' ) ){
                                                                                                                               /*
           Try to find attribute `NAME`:
                                                                                                                               */
           const Data::Cargo* cargo{ data.get( data.key( entity, gnosis.NAME ) ) };
           if( cargo ){ // name attribute should not contains spaces:
-            if( decorated ) return( kit( "%s%s%s", CYAN, cargo->lex.data, RESET ) );
-            return std::string( cargo->lex.data );
+            if( decorated ) return( kit( "%s%s%s", CYAN, cargo->c_str(), RESET ) );
+            return std::string( cargo->c_str() );
           }
         }
                                                                                                                               /*
@@ -239,7 +353,6 @@ namespace CoreAGI {
         }
         return NIL;
       }
-      auto name = it->second;
       bool quoted{ false };
       for( char symbol: name ){
         if( isalnum( symbol ) ) continue;
@@ -258,7 +371,7 @@ namespace CoreAGI {
           S << GREEN << name << RESET;
           return S.str();
         }
-        return name;
+        return std::string( name );
       }
     }
 
@@ -276,22 +389,9 @@ namespace CoreAGI {
       std::vector< Identity > sequence;
       entity.S().process( [&]( const Gnosis::Entity& e )->bool{ sequence.push_back( e.id ); return true; } );
                                                                                                                               /*
-      Sort sequence of ID ( VERB < non-VERB ):
-                                                                                                                              */
-      if( not sequence.empty() ) std::ranges::sort(
-        sequence,
-        [&]( Identity left, Identity right )->bool{
-          assert( left  );
-          assert( right );
-          Gnosis::Entity L{ gnosis.recover( left  ) };
-          Gnosis::Entity R{ gnosis.recover( right ) };
-          const bool Lv{ L.is( gnosis.VERB ) };
-          const bool Rv{ R.is( gnosis.VERB ) };
-          if( Lv == Rv      ) return true;
-          if( Lv and not Rv ) return true;
-          return false;
-        }
-      );
+      Order sequence of ID ( VERB < non-VERB ); each sign tested once:
+                                                                                                                              */
+      std::ranges::stable_partition( sequence, [&]( Identity id )->bool{ return gnosis.recover( id ).is( gnosis.VERB ); } ); // [m] 2026.10.19
                                                                                                                               /*
       Compose output as list of ref`s in the brackets:
                                                                                                                               */
@@ -305,7 +405,18 @@ namespace CoreAGI {
       return S.str();
     }//syndrome
 
-    std::string ref( const Gnosis::Entity& entity, const char* arg = " ", Dict dict = nullptr ) const {
+    std::string ref( const Gnosis::Entity& entity, const char* arg = " ", Dict dict = nullptr ) const {      // [m] 2026.10.19
+      const uint64_t key{ renderKey( entity.id, REF, arg, bool( dict ) ) };
+      if( const std::string* hit{ cached( key ) } ) return *hit;
+      return remember( key, compose( entity, arg, dict ) );
+    }
+
+  private:
+
+    std::string compose( const Gnosis::Entity& entity, const char* arg, Dict dict ) const {                   // [m] 2026.10.19
+                                                                                                                              /*
+      Rendering of ref(..) without cache:
+                                                                                                                              */
       const bool decorated = strchr( arg, 'c' );
       std::string name = lex( entity, arg, dict );
       if( not name.empty() ) return name;
@@ -337,6 +448,38 @@ namespace CoreAGI {
       return S.str();
     }
 
+    static bool imaged( const char* path ){                                                                    // [+] 2026.10.19
+                                                                                                                              /*
+      File starts with magic of the binary image:
+                                                                                                                              */
+      FILE* src = fopen( path, "rb" );
+      if( not src ) return false;
+      char magic[ sizeof( IMAGE_MAGIC ) ];
+      const bool ok{ fread( magic, sizeof( magic ), 1, src ) == 1 and memcmp( magic, IMAGE_MAGIC, sizeof( magic ) ) == 0 };
+      fclose( src );
+      return ok;
+    }
+
+    void plain( std::string& out, Identity id ) const {                                                        // [+] 2026.10.19
+                                                                                                                              /*
+      Append the same as `lexOrId( gnosis.recover( id ) )` (no decoration, no dictionary) without
+      temporary strings; safe for concurrent use while glossary not modified:
+                                                                                                                              */
+      const std::string_view name{ names.lex( id ) };
+      if( name.empty() ){
+        out += "[[";
+        out += Encoded< Identity >( id ).c_str();
+        out += "]]";
+        return;
+      }
+      const bool quoted{ std::ranges::any_of( name, []( char symbol ){ return not ( isalnum( symbol ) or symbol == '_' ); } ) };
+      if( quoted ) out += '\'';
+      out += name;
+      if( quoted ) out += '\'';
+    }
+
+  public:
+
     std::string lexOrId( const Gnosis::Entity& e, const char* arg = "", Dict dict = nullptr ) const {          // [+] 2021.04.24
                                                                                                                               /*
       Returns name of named entity or encoded ID of anonyvous entity
@@ -346,7 +489,18 @@ namespace CoreAGI {
       return name.empty() ? key( e, arg ) : name;
     }
 
-    std::string definition( const Gnosis::Entity& subj, const char* arg = " ", Dict dict = nullptr ) const {
+    std::string definition( const Gnosis::Entity& subj, const char* arg = " ", Dict dict = nullptr ) const { // [m] 2026.10.19
+      const uint64_t key{ renderKey( subj.id, DEFINITION, arg, bool( dict ) ) };
+      if( const std::string* hit{ cached( key ) } ) return *hit;
+      return remember( key, describe( subj, arg, dict ) );
+    }
+
+  private:
+
+    std::string describe( const Gnosis::Entity& subj, const char* arg, Dict dict ) const {                    // [m] 2026.10.19
+                                                                                                                              /*
+      Rendering of definition(..) without cache:
+                                                                                                                              */
       assert( gnosis.exist( subj.id ) );
       const bool decorated = strchr( arg, 'c' );
       constexpr char SPACE{ ' ' };
@@ -408,8 +562,8 @@ namespace CoreAGI {
             continue;
           }
           if( type == gnosis.STRING   ){
-            if( decorated ) S << xRED << '"' << RESET << CYAN << val->lex.data << xRED << '"' << RESET;
-            else            S <<         '"'                  << val->lex.data         << '"';
+            if( decorated ) S << xRED << '"' << RESET << CYAN << val->c_str() << xRED << '"' << RESET;
+            else            S <<         '"'                  << val->c_str()          << '"';
             continue;
           }
                                                                                                                               /*
@@ -435,7 +589,9 @@ namespace CoreAGI {
       if( decorated ) S << xRED << " ." << RESET; else S << " .";
       std::string result = S.str();
       return result;
-    }//definition
+    }//describe
+
+  public:
 
     std::string definition( const char* name, const char* arg = " ", Dict dict = nullptr ){
       const bool decorated = strchr( arg, 'c' );
@@ -457,67 +613,49 @@ namespace CoreAGI {
 
     std::string operator[]( const Gnosis::Entity& entity ) const { return lex( entity ); }                     // [+] 2020.11.08
 
-    bool let( const Gnosis::Entity& entity, const std::string& lex = NIL ){
+    bool let( const Gnosis::Entity& entity, std::string_view lex = NIL ){                                      // [m] 2026.10.19
       log.sure( gnosis.ID == entity.unit, kit( "Alien entity, gnosis`ID:%u, entity.unit: %u", gnosis.ID, entity.unit ) );
                                                                                                                               /*
-      Define, change, or destroy name of entity
-                                                                                                                              */
-      if( lex == NIL ){
-                                                                                                                              /*
-        Exclude `lex` and `id` from glossary:
-                                                                                                                              */
-        IDENTITY.erase( lex       );
-        LEX     .erase( entity.id );
-        return true;
-      }
-
-      const auto& it = LEX.find( entity.id );
-      if( it != LEX.end() ){
-                                                                                                                              /*
-        This name alrerady presented; do it refer provided identity?
-                                                                                                                              */
-        std::string oldName = it->second;
-                                                                                                                              /*
-        Reject assigning `lex` to provided identity if this `lex` already refers another identity:
+      Define, change, or destroy (empty `lex`) name of entity; mapping stays one-to-one, so entity
+      that had this name before loses it:
                                                                                                                               */
-        if( IDENTITY[ oldName ] != entity.id ) return false;
-                                                                                                                              /*
-        Remove oldName from glossary:
-                                                                                                                              */
-        IDENTITY.erase( oldName );
-      }
-                                                                                                                              /*
-      Add mapping name <-> identity into glossary:
-                                                                                                                              */
-      if( lex != NIL ){
-        LEX     [ entity.id ] = lex;
-        IDENTITY[ lex       ] = entity.id;
-      }
+      names.let( entity.id, lex );                                                                             // [m] 2026.10.19
       return true;
     }
 
-    bool dump( const char* path ) const {                                                                   // [+] 20-21.04.29
+    bool dump( const char* path ) const {                                                                   // [m] 2026.10.19
       log( kit( "Dump as `%s`...", path ) ); log.flush();
       std::unordered_set< Identity > congenital;
       for( const auto& e: gnosis.CONGENITAL ) congenital.insert( e.id );
       FILE* out = fopen( path, "w" );
       if( not out ){ log.vital( kit( "File `%s` not found", path ) ); return false; }
-      std::vector< Identity > data;
-      gnosis.process(
-        data,
-        [&]( std::vector< Identity >& data )->bool{
-          const unsigned L = data.size(); assert( L );
-          if( not congenital.contains( data.front() ) ){
-            for( int i=0; const auto id: data ){
-              fprintf( out, "%s%s", lexOrId( gnosis.recover( id ) ).c_str(), i>0?" ":": ");
-              i++;
-            }
-            fprintf( out, ";\n" );
-          }
-          return true;
+                                                                                                                              /*
+      Segments frozen (so dump is consistent), formatted in parallel into own buffers, one thread
+      per segment, and written in order by single `fwrite` each:
+                                                                                                                              */
+      constexpr unsigned N{ Config::gnosis::NUMBER_OF_SEGMENTS };
+      Gnosis::Shard::Frozen frozen[ N ];
+      gnosis.freeze( frozen );
+      std::string text[ N ];
+      auto format = [&]( unsigned s ){
+        for( const auto& entry: frozen[s].syndromes ){
+          if( congenital.contains( Identity( entry.key ) ) ) continue;
+          plain( text[s], Identity( entry.key ) );
+          text[s] += ": ";
+          for( const auto signId: entry.val ){ plain( text[s], signId ); text[s] += ' '; }
+          text[s] += ";\n";
         }
-      );
-      fclose( out );
+      };
+      std::vector< std::thread > T;
+      for( unsigned s = 0; s < N; s++ ) T.push_back( std::thread( format, s ) );
+      bool ok{ true };
+      for( unsigned s = 0; s < N; s++ ){
+        T[s].join();
+        ok = ( fwrite( text[s].data(), 1, text[s].size(), out ) == text[s].size() ) and ok;
+        std::string().swap( text[s] );
+      }
+      ok = ( fclose( out ) == 0 ) and ok;
+      if( not ok ){ log.vital( kit( "  Can`t write `%s`", path ) ); log.flush(); return false; }
       return true;
     }
 
@@ -526,38 +664,157 @@ namespace CoreAGI {
       FILE* out = fopen( path, "w" );
       if( not out ){ log.vital( kit( "File `%s` not found", path ) ); return false; }
       unsigned n{ 0 };
-      for( const auto& it: LEX ){
-        Encoded< Identity > key( it.first );
-        fprintf( out, "%s %s\n", key.c_str(), it.second.c_str() );
-        n++;
+      bool     ok{ true };
+      {
+        EncodedWriter writer( out );                                                                           // [m] 2026.10.19
+        names.each( [&]( Identity id, std::string_view name ){                                                 // [m] 2026.10.19
+          writer.put( id );
+          writer.put( ' ' );
+          writer.put( name );
+          writer.put( '\n' );
+          n++;
+        });
+        ok = writer.flush();
       }
-      fclose( out );
+      ok = ( fclose( out ) == 0 ) and ok;
+      if( not ok ){ log.vital( kit( "  Can`t write `%s`", path ) ); log.flush(); return false; }
       log( kit( "  [ok] stored %u names", n ) ); log.flush();
       return true;
     }
 
+    size_t serialize( std::vector< uint8_t >& out ) const {                                                    // [+] 2026.10.19
+                                                                                                                              /*
+      Binary image in memory (see `image(..)`); returns number of names:
+                                                                                                                              */
+      std::vector< Names::Record > table;
+      std::vector< char >          blob;
+      names.image( table, blob );
+      ImageHeader header{};
+      memcpy( header.magic, IMAGE_MAGIC, sizeof( header.magic ) );
+      header.version = IMAGE_VERSION;
+      header.endian  = IMAGE_ENDIAN;
+      header.count   = table.size();
+      header.size    = blob.size();
+      header.crc     = crc32( blob.data(), blob.size(), crc32( table.data(), table.size()*sizeof( Names::Record ) ) );
+      const size_t bytes{ table.size()*sizeof( Names::Record ) };
+      out.resize( sizeof( header ) + bytes + blob.size() );
+      memcpy( out.data(),                            &header,      sizeof( header ) );
+      memcpy( out.data() + sizeof( header ),         table.data(), bytes            );
+      memcpy( out.data() + sizeof( header ) + bytes, blob .data(), blob.size()      );
+      return table.size();
+    }
+
+    bool image( const char* path ) const {                                                                     // [+] 2026.10.19
+                                                                                                                              /*
+      Save binary image (usually `Config::glossary::IMAGE` next to the Gnosis image); temporary
+      file renamed after written, so existing image is never damaged:
+                                                                                                                              */
+      namespace fs = std::filesystem;
+      log( kit( "Save image as `%s`...", path ) ); log.flush();
+      Timer timer;
+      std::vector< uint8_t > out;
+      const size_t n{ serialize( out ) };
+      const fs::path pathTemp{ std::string( path ) + "~" };
+      FILE* dst = fopen( pathTemp.string().c_str(), "wb" );
+      if( not dst ){ log.vital( kit( "  Can`t create `%s`", pathTemp.string().c_str() ) ); return false; }
+      bool ok = fwrite( out.data(), 1, out.size(), dst ) == out.size();
+      ok = ( fflush( dst ) == 0 ) and ok;
+      ok = ok and ( fsync( fileno( dst ) ) == 0 );
+      ok = ( fclose( dst ) == 0 ) and ok;
+      std::error_code error;
+      if( ok ) fs::rename( pathTemp, path, error );
+      if( not ok or error ){
+        log.vital( kit( "  Can`t write `%s`", path ) ); log.flush();
+        fs::remove( pathTemp, error );
+        return false;
+      }
+      log( kit( "  [ok] stored %lu names in %.3f msec", n, timer.elapsed( Timer::MILLISEC ) ) );
+      return true;
+    }
+
+    bool restore( const char* path ){                                                                          // [+] 2026.10.19
+                                                                                                                              /*
+      Load binary image: checksum verified and existence of all entities checked in single pass
+      before current names replaced, so damaged or alien image changes nothing; sizes claimed
+      by the header checked against the file before anything allocated:
+                                                                                                                              */
+      log.vital( kit( "Restore from `%s`...", path ) ); log.flush();
+      Timer timer;
+      FILE* src = fopen( path, "rb" );
+      if( not src ){ log.vital( kit( "  File `%s` not found", path ) ); log.flush(); return false; }
+      ImageHeader                  header;
+      std::vector< Names::Record > table;
+      std::vector< char >          blob;
+      std::error_code              failure;                                                                    // [+] 2026.10.19
+      const uintmax_t              bytes{ std::filesystem::file_size( path, failure ) };                       // [+] 2026.10.19
+      bool ok = fread( &header, sizeof( header ), 1, src ) == 1;
+      const char* error{ nullptr };
+      if     ( not ok                                                      ) error = "too short file";
+      else if( memcmp( header.magic, IMAGE_MAGIC, sizeof( header.magic ) ) ) error = "not a glossary image";
+      else if( header.version != IMAGE_VERSION                             ) error = "unsupported version";
+      else if( header.endian  != IMAGE_ENDIAN                              ) error = "alien byte order";
+      else if( header.size    >= ( uint64_t( 1 ) << 32 )                   ) error = "too large blob";
+      else if( failure or header.count > ( bytes - sizeof( header ) )/sizeof( Names::Record )                  // [+] 2026.10.19
+               or sizeof( header ) + header.count*sizeof( Names::Record ) + header.size != bytes ) error = "size mismatch";
+      else {
+        table.resize( header.count );
+        blob .resize( header.size  );
+        if( fread( table.data(), sizeof( Names::Record ), table.size(), src ) != table.size()
+            or fread( blob.data(), 1, blob.size(), src ) != blob.size() ) error = "truncated file";
+        else if( crc32( blob.data(), blob.size(), crc32( table.data(), table.size()*sizeof( Names::Record ) ) ) != header.crc ){
+          error = "checksum mismatch";
+        }
+      }
+      fclose( src );
+      if( not error ){
+                                                                                                                              /*
+        Existence of the entities checked by parts of the table in parallel:
+                                                                                                                              */
+        constexpr unsigned         N{ Config::gnosis::NUMBER_OF_SEGMENTS };
+        std::atomic< bool >        alien{ false };
+        std::vector< std::thread > T;
+        const size_t part{ ( table.size() + N - 1 )/N };
+        for( unsigned t = 0; t < N; t++ ) T.push_back( std::thread( [&, t ]{
+          const size_t from{ std::min( table.size(), t*part ) }, to{ std::min( table.size(), from + part ) };
+          for( size_t i = from; i < to and not alien; i++ ) if( not gnosis.exists( table[i].id ) ) alien = true;
+        }));
+        for( auto& Ti: T ) Ti.join();
+        if( alien ) error = "entity not exists";
+      }
+      if( not error and not names.adopt( blob, table ) ) error = "inconsistent table of names";
+      if( error ){ log.vital( kit( "  Image `%s` rejected: %s", path, error ) ); log.flush(); return false; }
+      log.vital( kit( "  [ok] restored %lu names in %.3f msec", table.size(), timer.elapsed( Timer::MILLISEC ) ) ); log.flush();
+      return true;
+    }
+
     bool load( const char* path ){
+      if( imaged( path ) ) return restore( path );                                                             // [+] 2026.10.19
       log.vital( kit( "Load from `%s`...", path ) ); log.flush();
       FILE* src = fopen( path, "r" );
       if( not src ){ log.vital( kit( "  File `%s` not found", path ) ); log.flush(); return false; }
-      LEX     .clear();
-      IDENTITY.clear();
+      names.clear();                                                                                           // [m] 2026.10.19
       char name[ Config::glossary::CAPACITY_OF_LEX ];
       unsigned n{ 0 };
-      for(;;){
-        Encoded< Identity > EncodedID( src );
-        if( not bool( EncodedID ) ) break;
-        unsigned length{ 0 };
-        for(;;){
-          const int c{ fgetc( src ) };
-          if( c < 0 ) break; // :end of file
-          const char symbol = c;
-          if( symbol == '\n' ) break; // :end of record
-          if( length < Config::glossary::CAPACITY_OF_LEX - 1 ) name[ length++ ] = symbol;
+      EncodedReader           reader( src );                                                                   // [m] 2026.10.19
+      std::string_view        record;
+      std::vector< Identity > key;
+      while( reader.line( record ) ){
+                                                                                                                              /*
+        Record: encoded ID, single separator, name up to the end of line:
+                                                                                                                              */
+        const size_t begin{ record.find_first_not_of( " \t\r" ) };
+        if( begin == std::string_view::npos ) continue; // :empty line
+        const size_t end{ std::min( record.find_first_of( " \t\r", begin ), record.size() ) };
+        key.clear();
+        if( not EncodedReader::decode( record.substr( begin, end - begin ), key ) or key.size() != 1 ){
+          log.abend( kit( "Malformed record `%s`", std::string( record ).c_str() ) );
         }
+        const std::string_view lex{ end < record.size() ? record.substr( end + 1 ) : std::string_view{} };
+        const unsigned length( std::min< size_t >( lex.size(), Config::glossary::CAPACITY_OF_LEX - 1 ) );
+        memcpy( name, lex.data(), length );
         name[ length ] = '\0';
-        log.sure( length > 0, kit( "Empty name of `%s`", EncodedID.c_str() ) );
-        const Identity id{ Identity( EncodedID ) };
+        log.sure( length > 0, kit( "Empty name of `%s`", Encoded< Identity >( key[0] ).c_str() ) );
+        const Identity id{ key[0] };
         //assert( gnosis.exists( id ) );
         //log.sure( gnosis.exists( id ), kit( "Entity not exists: `%s`", name ) );                             // [-] 2020.11.27
         if( not gnosis.exists( id ) ){                                                                         // [+] 2020.11.28
@@ -565,15 +822,8 @@ namespace CoreAGI {
           S << "Entity not exists: `" << name << '`';
           log.abend( S.str() );
         }
-        if( not gnosis.exists( id ) ){
-          std::stringstream S;
-          S << "Entity not exists: `" << name << "`";
-          log.abend( S.str() );
-        }
-        const std::string lx{ name };
-        // log.vital( kit( "  %-8s %8u", lx.c_str(), id ) );                                                            // DEBUG
-        LEX     [ id ] = lx;
-        IDENTITY[ lx ] = id;
+        // log.vital( kit( "  %-8s %8u", name, id ) );                                                                  // DEBUG
+        names.let( id, std::string_view( name, length ) );                                                     // [m] 2026.10.19
         n++;
       }
       fclose( src );
@@ -16,6 +16,7 @@
         public  class Entity    - refers entity in a particular unit
         public  class Syndrome  - represents set of entities (belonged to particular unit)
           public class Iter     - range iterator of goup`s members (entities)
+        public  class Snapshot  - immutable image of the knowledge graph
 
 ________________________________________________________________________________________________________________________________
 
@@ -75,6 +76,44 @@ ________________________________________________________________________________
 
   2021.06.06 Added Gnosis::Entity.attributes() method
 
+  2026.10.19 Added Gnosis::Snapshot - immutable versioned image of the graph (MVCC) and
+             Gnosis.snapshot(); Gnosis.analogic(..) can be executed over snapshot;
+             Added Gnosis::Batch (see `batch.h`)
+             Gnosis.save(..) / Gnosis.load(..) use binary image of the graph with header
+             (version, byte order, segments layout) and CRC-checked delta+varint coded
+             per-segment sections; image loaded via `mmap`; legacy text files still loaded
+             Gnosis.restore(..) decodes image into fresh segments swapped in only when the
+             whole image decoded
+             Gnosis.save(..) can write VERBATIM image with map pages as is; such pages used
+             by the segments directly from private file mapping (zero-copy restore); pages checked
+             by CRC-32 kept in the head of the section and keys of entries checked before adoption
+             Sections of the image encoded, written, checked and decoded in parallel, one
+             thread per segment; image encoded from frozen segments out of commit lock
+             Added Gnosis.saveText(..); text files written and read via block-buffered
+             `EncodedWriter` / `EncodedReader` (see `codec.h`)
+             Added Gnosis.checkpoint(..): incremental checkpoints with VERBATIM base, DELTA images
+             of changed pages and sequence buckets, manifest and periodic compaction;
+             Gnosis.restoreCheckpoint(..) keeps the graph if chain rejected
+             Added Gnosis.checkpointInBackground(..): frozen images written by dedicated thread
+             with limited bandwidth; manifest keeps journal LSN fence (see `checkpointFence()`)
+             Added Gnosis.onPersistIncl(..) / Gnosis.onPersistExcl(..): images of ancillary storages
+             (e.g. `Data::Mini`) written with the graph image or checkpoint and loaded with the graph;
+             storages serialized under commit lock with freezing of the graph, files written out of
+             the lock (by the checkpointer thread for background checkpoint) and referred by manifest
+             Added Gnosis.select( syndrome, candidates, f ): syndrome match over candidate set produced
+             by value predicate (see `Data::Mini::selectIntegers(..)`)
+             Added congenital SPAN: type of the Span-valued attributes
+             Added Gnosis.version(): counter of modifications of the graph
+             Gnosis.analogic(..): search run by all hardware threads; idle worker steals upper half
+             of untried candidates of the shallowest frame of other worker
+             Gnosis.analogic(..): candidate adjacency over each pattern edge precomputed before
+             search; EDGE test is lookup in short sorted list, NODE iterates over the shortest
+             list of candidates linked with assigned neighbours
+             Gnosis.analogic(..): generic join (see ANALOGIC_JOIN) - frame of the node is intersection
+             of the sorted lists of candidates linked with all assigned neighbours (leapfrog seek)
+             Gnosis.analogic(..): arc consistency (AC-3) pre-pass removes candidates without support
+             over some edge of the pattern before estimation of complexity; edges revised in parallel
+
   __________________________________________________________
 
   TODO:
@@ -88,34 +127,47 @@ ________________________________________________________________________________
 
   [+] 2021.01.02 Implement multithreding version of the into Gnosis.analogic()
 
-  [-]            Add endianness coversion to `codec.h` (or check it)
+  [+] 2026.10.19 Add endianness coversion to `codec.h` (or check it)
+                 :byte order checked by the header of the binary image
 
-  [-]            Add header into file with Gnosis` data dump that refers version and andianness
+  [+] 2026.10.19 Add header into file with Gnosis` data dump that refers version and andianness
 
 ________________________________________________________________________________________________________________________________
                                                                                                                               */
 #ifndef GNOSIS_H_INCLUDED
 #define GNOSIS_H_INCLUDED
 
+#include <fcntl.h>         // :open                                                                            // [+] 2026.10.19
 #include <stdio.h>
+#include <sys/mman.h>      // :mmap                                                                            // [+] 2026.10.19
+#include <sys/stat.h>      // :fstat                                                                           // [+] 2026.10.19
+#include <unistd.h>        // :close, fsync                                                                    // [+] 2026.10.19
 #include <cmath>           // :log
+#include <cstddef>         // :offsetof                                                                        // [+] 2026.10.19
+#include <cstring>         // :memcmp                                                                          // [+] 2026.10.19
 
+#include <algorithm>       // :sort, lower_bound                                                               // [+] 2026.10.19
 #include <atomic>
 #include <bit>             // :endianness
 #include <bitset>
 #include <chrono>
+#include <condition_variable>                                                                                  // [+] 2026.10.19
 #include <filesystem>
 #include <functional>
 #include <map>
+#include <memory>                                                                                              // [+] 2026.10.19
 #include <mutex>
 #include <random>
 #include <set>
 #include <span>
+#include <string>                                                                                              // [+] 2026.10.19
 #include <thread>
 #include <unordered_set>
 #include <vector>
 
 #include "codec.h"
+#include "crc.h"                                                                                               // [+] 2026.10.19
+#include "journal.h"                                                                                           // [+] 2026.10.19
 #include "logger.h"
 #include "set.h"
 #include "random.h"
@@ -168,6 +220,7 @@ namespace CoreAGI {
 
     class Syndrome;
     class Sequence;
+    class Batch;    // :defined in `batch.h`                                                                   // [+] 2026.10.19
 
 
     class Entity: public Local {
@@ -219,7 +272,7 @@ namespace CoreAGI {
         for( const auto& sign: syndrome ){
           assert( sign.id != CoreAGI::NIHIL );
           Shard& segment = gnosis().segment( id );
-          Signs* Y{ segment[id] }; assert( Y );
+          Signs* Y{ segment.mod( id ) }; assert( Y );                                                          // [m] 2026.10.19
           assert( Y->incl( sign.id ) );
           // gnosis().log.vital( kit( "  Congenital syndrome: %8u --> %8u", id, sign.id ) ); gnosis().log.flush();      // DEBUG
         }
@@ -295,7 +348,7 @@ namespace CoreAGI {
                                                                                                                               /*
         Be shure that this entity is not IMMORTAL:
                                                                                                                               */
-        Signs* Y{ shard[ id ] };  assert( Y );
+        const Signs* Y{ shard[ id ] };  assert( Y );                                                           // [m] 2026.10.19
         if( Y->contains( G.IMMORTAL.id ) ) return false;
                                                                                                                               /*
         Execute external event processors:
@@ -319,7 +372,7 @@ namespace CoreAGI {
         assert( mate( sign ) );
         Gnosis&  G      { gnosis()      };
         Shard& segment{ G.segment( id ) };
-        Signs* Y{ segment[id] }; assert( Y );
+        Signs* Y{ segment.mod( id ) }; assert( Y );                                                            // [m] 2026.10.19
         sign.S().process(
                                                                                                                               /*
           Add heritable signs of the adding sign and remove mutually exclusive signs:
@@ -340,11 +393,11 @@ namespace CoreAGI {
       Entity& incl( std::initializer_list< Entity > syndrome ){                                                // [+] 2020.07.31
         Gnosis& G      { gnosis()        };
         Shard&  segment{ G.segment( id ) };
-        Signs*  Y      { segment[id]     }; assert( Y );
+        const Signs* Y{ segment[id] }; assert( Y );
         if( not Y->contains( G.IMMUTABLE.id ) ) for( const auto& sign: syndrome ){
           if( sign.id == CoreAGI::NIHIL ) continue;
           assert( mate( sign ) );
-          Y->incl( sign.id );
+          segment.mod( id )->incl( sign.id );                                                                  // [m] 2026.10.19
         }
         return *this;
       }
@@ -354,7 +407,7 @@ namespace CoreAGI {
         assert( mate( sign ) );
         Gnosis& G      { gnosis()        };
         Shard&  segment{ G.segment( id ) };
-        Signs*  Y      { segment[id]     }; assert( Y );
+        Signs*  Y      { segment.mod( id ) }; assert( Y );                                                     // [m] 2026.10.19
         Y->excl( sign.id );
         return *this;                                                                                          // [+] 2020.07.31
       }
@@ -362,11 +415,11 @@ namespace CoreAGI {
       Entity& excl( std::initializer_list< Entity > syndrome ){                                                // [+] 2020.07.31
         Gnosis& G      { gnosis()        };
         Shard&  segment{ G.segment( id ) };
-        Signs*  Y      { segment[id]     }; assert( Y );
+        const Signs* Y{ segment[id] }; assert( Y );
         if( not Y->contains( G.IMMUTABLE.id ) ) for( const auto& sign: syndrome ){
           if( sign.id == CoreAGI::NIHIL ) continue;
           assert( mate( sign ) );
-          Y->excl( sign.id );
+          segment.mod( id )->excl( sign.id );                                                                  // [m] 2026.10.19
         }
         return *this;
       }
@@ -416,9 +469,9 @@ namespace CoreAGI {
       bool is( const Entity& sign ) const {
         if( sign.id == CoreAGI::NIHIL ) return false;
         if( not mate( sign )          ) return false;
-        Gnosis& G      { gnosis()        };
-        Shard&  segment{ G.segment( id ) };
-        Signs*  Y      { segment[id]     }; assert( Y );
+        const Gnosis& G      { gnosis()        };                                                              // [m] 2026.10.19
+        const Shard&  segment{ G.segment( id ) };                                                              // [m] 2026.10.19
+        const Signs*  Y      { segment[id]     }; assert( Y );                                                 // [m] 2026.10.19
         return Y->contains( sign.id );
       }
 
@@ -427,6 +480,7 @@ namespace CoreAGI {
         if(     is( gnosis().INTEGER   ) ) return gnosis().INTEGER;
         if(     is( gnosis().RATIONAL  ) ) return gnosis().RATIONAL;
         if(     is( gnosis().STRING    ) ) return gnosis().STRING;
+        if(     is( gnosis().SPAN      ) ) return gnosis().SPAN;                                              // [+] 2026.10.19
         return gnosis().none();
       };
 
@@ -449,7 +503,7 @@ namespace CoreAGI {
         Seq S;
         const unsigned n = sequence.size();
         for( unsigned i = 0; i < n; i++ ) S += sequence[i].id;
-        segment.sequences[id] = S;
+        segment.seq( id, S );                                                                                  // [m] 2026.10.19
         return true;
       }
 
@@ -460,7 +514,7 @@ namespace CoreAGI {
         bool ok{ true };
         Seq S;
         for( const auto& entity: sequenceOfEntities ){ if( mate( entity ) ) S += entity.id; else ok = false; }
-        segment.sequences[id] = S;
+        segment.seq( id, S );                                                                                  // [m] 2026.10.19
         return ok;
       }
 
@@ -482,6 +536,7 @@ namespace CoreAGI {
 
     const char*           TITLE;
     const unsigned        ID;                             // :Gnosis instance ID
+    Logger&               logger;                         // :for logging channels of auxiliary threads        // [+] 2026.10.19
     Logger::Log           log;                            // :Gnosis instance` log
     Shard                 segments[ NUMBER_OF_SEGMENTS ]; // :segments                                         // [+] 2020.07.11
     mutable Arena         arena;                          // :arena allocator
@@ -494,8 +549,63 @@ namespace CoreAGI {
       When `attr` is `true` it meand that ID refers attribite entity
                                                                                                                               */
     std::map< Identity, std::function< void( const Identity&, const Identity&, bool attr ) > > onChangeID;     // [m] 2021.06.13
+                                                                                                                              /*
+    Ancillary storages kept with the graph image or checkpoint (see `onPersistIncl(..)`): storage
+    serialized into memory under commit lock together with freezing of the graph, so image matches
+    frozen graph; file written later out of the lock:
+                                                                                                                              */
+    struct Persist {                                                                                           // [+] 2026.10.19
+      std::string                                        name;   // :file name of the image
+      std::function< void( std::vector< uint8_t >& ) >   image;  // :serialize storage
+      std::function< bool( const char* path ) >          load;
+    };
+
+    std::map< Identity, Persist > onPersist;                                                                   // [+] 2026.10.19
 
     static std::mutex globalMutex;                        // :static
+    mutable std::mutex commitMutex;                       // :serializes batch commits and snapshots           // [+] 2026.10.19
+                                                                                                                              /*
+    Image of ancillary storage taken together with frozen graph (see `freeze(..)`):
+                                                                                                                              */
+    struct Annex {                                                                                             // [+] 2026.10.19
+      std::string            name;   // :file name of the image (see `onPersistIncl(..)`)
+      std::vector< uint8_t > bytes;
+    };
+                                                                                                                              /*
+    State of the chain of incremental checkpoints (see `checkpoint(..)`):
+                                                                                                                              */
+    struct Checkpoint {                                                                                        // [+] 2026.10.19
+      std::string   folder;                        // :folder of the current chain; empty if no chain
+      uint32_t      generation{ 0 };               // :of the base and deltas, increased by compaction
+      uint32_t      deltas    { 0 };               // :number of deltas after the base
+      uint64_t      baseBytes { 0 };
+      uint64_t      deltaBytes{ 0 };               // :total size of the deltas
+      uint64_t      fence     { 0 };               // :journal LSN covered by the last checkpoint          // [+] 2026.10.19
+      Shard::Frozen frozen[ NUMBER_OF_SEGMENTS ];  // :graph as it written by the last checkpoint
+    };
+
+    Checkpoint checkpointed;                                                                                   // [+] 2026.10.19
+    std::mutex checkpointMutex;                                                                                // [+] 2026.10.19
+                                                                                                                              /*
+    Background checkpointing (see `checkpointInBackground(..)`); request holds frozen images,
+    so the graph can be modified while the dedicated thread writes them:
+                                                                                                                              */
+    struct Background {                                                                                        // [+] 2026.10.19
+      std::thread                        thread;
+      std::mutex                         mutex;
+      std::condition_variable            wake;       // :request posted or stop requested
+      std::condition_variable            idle;       // :request processed
+      std::string                        folder;     // :of the posted request
+      std::unique_ptr< Shard::Frozen[] > frozen;     // :of the posted request; null if nothing posted
+      std::vector< Annex >               annexes;    // :of the posted request
+      uint64_t                           fence  { 0     };
+      unsigned                           bandwidth{ 0   }; // :MB/sec, 0 - unlimited
+      bool                               busy   { false }; // :request is being written
+      bool                               stop   { false };
+      bool                               ok     { true  }; // :result of the last request
+    };
+
+    Background background;                                                                                     // [+] 2026.10.19
 
   public:
                                                                                                                               /*
@@ -539,6 +649,7 @@ namespace CoreAGI {
     Entity RUN;
     Entity SEQ;
     Entity SEQUENCE;
+    Entity SPAN;                // [+] 2026.10.19
     Entity STRING;
     Entity SUM;
     Entity SWAP;
@@ -552,6 +663,233 @@ namespace CoreAGI {
                                                                                                                               */
     const Shard& segment( Identity i ) const { return segments[ i % NUMBER_OF_SEGMENTS ]; }                    // [+] 2020.07.27
           Shard& segment( Identity i )       { return segments[ i % NUMBER_OF_SEGMENTS ]; }                    // [m] 2020.07.11
+                                                                                                                              /*
+    Binary image of the graph: header, table of segment sections, sections (see `Segment.image(..)`):
+                                                                                                                              */
+    static constexpr char     IMAGE_MAGIC[ 8 ]{ 'G', 'e', 'l', 'G', 'N', 'O', '0', '1' };                      // [+] 2026.10.19
+    static constexpr uint32_t IMAGE_VERSION   { 1          };
+    static constexpr uint32_t IMAGE_ENDIAN    { 0x01020304 }; // :written in native byte order
+
+    struct ImageHeader {                                                                                       // [+] 2026.10.19
+      char     magic[ 8 ];
+      uint32_t version;
+      uint32_t endian;
+      uint32_t segments;  // :NUMBER_OF_SEGMENTS
+      uint32_t capacity;  // :CAPACITY_OF_SEGMENT
+      uint32_t syndrome;  // :CAPACITY_OF_SYNDROME
+      uint32_t crc;       // :CRC-32 of the table of sections
+    };
+
+    struct ImageSection {                                                                                      // [+] 2026.10.19
+      uint64_t offset;    // :from the begin of file
+      uint64_t size;      // :bytes
+      uint32_t syndromes; // :number of syndromes
+      uint32_t sequences; // :number of sequences
+      uint32_t crc;       // :CRC-32 of the section (of the head with CRC-32 of pages for VERBATIM / DELTA)
+      uint32_t layout;    // :see Layout                                                                       // [m] 2026.10.19
+    };
+
+    static_assert( sizeof( ImageHeader ) == 32 and sizeof( ImageSection ) == 32 );
+                                                                                                                              /*
+    Manifest of the incremental checkpoints: base image `checkpoint.<generation>.img` (VERBATIM)
+    followed by deltas `checkpoint.<generation>.<1..deltas>` (DELTA); images of ancillary storages
+    written as `checkpoint.<generation>.<deltas>.<name>` before manifest refers them:
+                                                                                                                              */
+    static constexpr char CHECKPOINT_MAGIC[ 8 ]{ 'G', 'e', 'l', 'C', 'H', 'K', '0', '1' };                    // [+] 2026.10.19
+
+    struct Manifest {                                                                                          // [+] 2026.10.19
+      char     magic[ 8 ];
+      uint32_t generation;
+      uint32_t deltas;
+      uint64_t fence;     // :LSN of the last journaled batch contained in the checkpoint                    // [+] 2026.10.19
+      uint32_t reserved;
+      uint32_t crc;       // :CRC-32 of preceding fields
+    };
+
+    static_assert( sizeof( Manifest ) == 32 );
+
+    static std::filesystem::path checkpointFile( const std::filesystem::path& dir, uint32_t generation, uint32_t delta ){
+                                                                                                                              /*
+      Path to the base (`delta` == 0) or delta of the checkpoint:
+                                                                                                                              */
+      char name[ 64 ];
+      if( delta ) snprintf( name, sizeof( name ), "%s.%u.%u",   CHECKPOINT, generation, delta );
+      else        snprintf( name, sizeof( name ), "%s.%u.img",  CHECKPOINT, generation        );
+      return dir/std::filesystem::path( name );
+    }
+
+    static std::string annexPrefix( uint32_t generation, uint32_t delta ){                                     // [+] 2026.10.19
+                                                                                                                              /*
+      Prefix of the file names of ancillary images of the checkpoint (see `Manifest`):
+                                                                                                                              */
+      return kit( "%s.%u.%u.", CHECKPOINT, generation, delta );
+    }
+
+    static bool readManifest( const std::filesystem::path& path, Manifest& M ){                                // [+] 2026.10.19
+      FILE* src = fopen( path.string().c_str(), "rb" );
+      if( not src ) return false;
+      const bool ok{ fread( &M, sizeof( M ), 1, src ) == 1 };
+      fclose( src );
+      return ok and not memcmp( M.magic, CHECKPOINT_MAGIC, sizeof( M.magic ) ) and M.crc == crc32( &M, offsetof( Manifest, crc ) );
+    }
+
+    bool writeManifest( const std::filesystem::path& path,                                                     // [+] 2026.10.19
+                        uint32_t generation, uint32_t deltas, uint64_t fence, const Logger::Log& log ) const {
+                                                                                                                              /*
+      Replace manifest atomically (write temporary file then rename it); `log` is the channel
+      of the calling thread:
+                                                                                                                              */
+      namespace fs = std::filesystem;
+      Manifest M{};
+      memcpy( M.magic, CHECKPOINT_MAGIC, sizeof( M.magic ) );
+      M.generation = generation;
+      M.deltas     = deltas;
+      M.fence      = fence;
+      M.crc        = crc32( &M, offsetof( Manifest, crc ) );
+      const fs::path pathTemp{ path.string() + "~" };
+      FILE* out = fopen( pathTemp.string().c_str(), "wb" );
+      if( not out ) return false;
+      bool ok = fwrite( &M, sizeof( M ), 1, out ) == 1;
+      ok = ( fflush( out ) == 0 ) and ok;
+      ok = ok and ( fsync( fileno( out ) ) == 0 );
+      fclose( out );
+      std::error_code error;
+      if( ok ) fs::rename( pathTemp, path, error );
+      if( not ok or error ){
+        log( kit( "Can`t write `%s`", path.string().c_str() ) );
+        fs::remove( pathTemp, error );
+        return false;
+      }
+      return true;
+    }
+
+    void thaw( const Shard::Frozen* frozen ){                                                                  // [+] 2026.10.19
+                                                                                                                              /*
+      Replace content of all segments by frozen images (see `Segment.freeze()`) at once for batches:
+                                                                                                                              */
+      std::lock_guard< std::mutex > lock( commitMutex );
+      for( unsigned i = 0; i < NUMBER_OF_SEGMENTS; i++ ) segments[i].adopt( frozen[i] );
+    }
+
+    template< typename Job > static void parallel( Job job ){                                                  // [+] 2026.10.19
+                                                                                                                              /*
+      Execute `job( i )` for each segment index in separate threads:
+                                                                                                                              */
+      std::vector< std::thread > T;
+      for( unsigned s = 0; s < NUMBER_OF_SEGMENTS; s++ ) T.push_back( std::thread( job, s ) );
+      for( auto& Ti: T ) Ti.join();
+    }
+
+    bool restore( const char* path, bool delta = false ){                                                      // [+] 2026.10.19
+                                                                                                                              /*
+      Load binary image mapped into memory; whole file checked and decoded into fresh segments
+      that replace the current ones only when all sections decoded, so damaged image does not
+      destroy current content (see `thaw(..)`). Mapping is private, so pages of VERBATIM
+      sections are used as segment storage directly and kept mapped while any segment or
+      snapshot refers them; pages checked by their CRC-32 (see `Segment.check(..)`) before adopted.
+      Sections checked and decoded in parallel, one thread per segment:
+
+      With `delta` the image has to consist of DELTA sections that applied to the copy of the current
+      graph (see `checkpoint(..)`); the graph unchanged if delta rejected:
+                                                                                                                              */
+      log( kit( "  %s `%s`..", delta ? "Apply delta" : "Load image", path ) ); log.flush();                   // [m] 2026.10.19
+      Timer timer;
+      const int fd{ ::open( path, O_RDONLY ) };
+      if( fd < 0 ){
+        log( kit( "  Can`t open `%s`: %s", path, strerror( errno ) ) );
+        return false;
+      }
+      struct stat st;
+      const size_t size{ fstat( fd, &st ) == 0 ? size_t( st.st_size ) : 0 };
+      void* addr{ size > 0 ? mmap( nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0 ) : MAP_FAILED }; // [m] 2026.10.19
+      ::close( fd );
+      if( addr == MAP_FAILED ){
+        log( kit( "  Can`t map `%s`", path ) );
+        return false;
+      }
+      const std::shared_ptr< uint8_t > image( static_cast< uint8_t* >( addr ), [size]( uint8_t* a ){ munmap( a, size ); } );
+      uint8_t* base{ image.get() };
+      constexpr size_t PROLOG{ sizeof( ImageHeader ) + NUMBER_OF_SEGMENTS*sizeof( ImageSection ) };
+      const ImageSection* T{ reinterpret_cast< const ImageSection* >( base + sizeof( ImageHeader ) ) };
+      bool verbatim{ false };                                                                                  // [+] 2026.10.19
+      if( size >= PROLOG ) for( unsigned i = 0; i < NUMBER_OF_SEGMENTS; i++ ) verbatim |= ( T[i].layout != PACKED );
+      if( not verbatim ) madvise( addr, size, MADV_WILLNEED ); // :whole file will be read                    // [m] 2026.10.19
+      auto checkHeader = [&]()->const char*{                                                                   // [m] 2026.10.19
+        if( size < PROLOG ) return "truncated file";
+        const ImageHeader& H{ *reinterpret_cast< const ImageHeader* >( base ) };
+        if( memcmp( H.magic, IMAGE_MAGIC, sizeof( H.magic ) ) ) return "not a Gnosis image";
+        if( H.endian   != IMAGE_ENDIAN                        ) return "byte order mismatch";
+        if( H.version  != IMAGE_VERSION                       ) return "unsupported version";
+        if( H.segments != NUMBER_OF_SEGMENTS                  ) return "number of segments mismatch";
+        if( H.capacity != CAPACITY_OF_SEGMENT                 ) return "capacity of segment mismatch";         // [+] 2026.10.19
+        if( H.syndrome != CAPACITY_OF_SYNDROME                ) return "capacity of syndrome mismatch";        // [+] 2026.10.19
+        if( H.crc != crc32( T, NUMBER_OF_SEGMENTS*sizeof( ImageSection ) ) ) return "damaged table of sections";
+        return nullptr;
+      };
+      const std::unique_ptr< Shard[] > fresh{ new Shard[ NUMBER_OF_SEGMENTS ] }; // :not started               // [+] 2026.10.19
+      for( unsigned i = 0; i < NUMBER_OF_SEGMENTS; i++ ) fresh[i].id = i; // :entities checked against segment index
+      auto checkSection = [&]( unsigned i )->const char*{                                                      // [+] 2026.10.19
+        if( T[i].offset < PROLOG or T[i].offset > size or T[i].size > size - T[i].offset ) return "truncated file";
+        uint64_t checked{ T[i].size };
+        if( T[i].layout == VERBATIM or T[i].layout == DELTA ){ // Head checksummed, pages checked by the head: // [m] 2026.10.19
+          if( T[i].layout == DELTA and not delta ) return "unexpected delta section";                          // [m] 2026.10.19
+          Shard::Verbatim V;
+          if( T[i].offset % Shard::ALIGNMENT or T[i].size < sizeof( V ) ) return "malformed section";
+          memcpy( &V, base + T[i].offset, sizeof( V ) );
+          if( V.head > T[i].size ) return "malformed section";
+          checked = V.head;
+        } else if( T[i].layout != PACKED ) return "unknown layout of section";
+        if( delta and T[i].layout != DELTA ) return "delta expected";
+        if( T[i].crc != crc32( base + T[i].offset, checked ) ) return "damaged section";
+        const std::span< const uint8_t > section( base + T[i].offset, T[i].size );                             // [+] 2026.10.19
+        if( T[i].layout != PACKED and not fresh[i].check( section, T[i].layout == DELTA ) ) return "damaged page"; // [+] 2026.10.19
+        return nullptr;
+      };
+      auto decodeSection = [&]( unsigned i )->const char*{                                                     // [+] 2026.10.19
+        unsigned Ns{ 0 };
+        unsigned Nq{ 0 };
+        const std::span< uint8_t > section( base + T[i].offset, T[i].size );
+        bool ok{ false };
+        switch( T[i].layout ){                                                                                 // [+] 2026.10.19
+          case PACKED   : ok = fresh[i].restore( section, Ns, Nq );     break;
+          case VERBATIM : ok = fresh[i].adopt  ( section, image, Nq );  break;
+          case DELTA    : ok = fresh[i].patch  ( section, image, Nq );  break;
+          default       : break;
+        }
+        if( T[i].layout != PACKED ) Ns = fresh[i].size();
+        return ok and Ns == T[i].syndromes and Nq == T[i].sequences ? nullptr : "malformed section";
+      };
+      const char* error{ checkHeader() };
+      const char* errors[ NUMBER_OF_SEGMENTS ]{};                                                              // [+] 2026.10.19
+      auto firstError = [&]()->const char*{
+        for( const char* e: errors ) if( e ) return e;
+        return nullptr;
+      };
+      if( not error ){
+        parallel( [&]( unsigned i ){ errors[i] = checkSection( i ); } );
+        error = firstError();
+      }
+      if( not error ){
+        if( delta ){ // :deltas applied to the copy of the current graph                                       // [+] 2026.10.19
+          std::vector< Shard::Frozen > current( NUMBER_OF_SEGMENTS );
+          freeze( current.data() );
+          for( unsigned i = 0; i < NUMBER_OF_SEGMENTS; i++ ) fresh[i].adopt( current[i] );
+        }
+        parallel( [&]( unsigned i ){ errors[i] = decodeSection( i ); } );
+        error = firstError();
+      }
+      if( not error ){                                                                                         // [+] 2026.10.19
+        std::vector< Shard::Frozen > decoded( NUMBER_OF_SEGMENTS );
+        for( unsigned i = 0; i < NUMBER_OF_SEGMENTS; i++ ) decoded[i] = fresh[i].freeze();
+        thaw( decoded.data() );
+      }
+      if( error ){
+        log( kit( "  Image `%s` rejected: %s", path, error ) );
+        return false;
+      }
+      log( kit( "  Graph with %lu nodes loaded in %.3f msec", this->size(), timer.elapsed( Timer::MILLISEC ) ) );
+      return true;
+    }
 
     bool is( const Identity& e, const Identity& s ) const {                                                 // [+] 2020.12.21
       printf( "\n  [Gnosis.is] %u %u\n", e, s ); fflush( stdout ); // DEBUG
@@ -582,11 +920,18 @@ namespace CoreAGI {
     void finish(){ for( auto& S: segments ) S.terminate(); }
 
   public: // Gnosis
+                                                                                                                              /*
+    Layout of the segment section; PACKED is compact but decoded at load, VERBATIM contains
+    map pages as is that are mapped at load and paged in lazily when touched (see `Segment.adopt(..)`);
+    DELTA contains changes since previous checkpoint (see `checkpoint(..)`):
+                                                                                                                              */
+    enum Layout: uint32_t { PACKED = 0, VERBATIM = 1, DELTA = 2 };                                             // [m] 2026.10.19
 
     Gnosis( const char* title, Logger& logger ):
 
       TITLE      { title                          },  // :assign Gnosis` instange name
       ID         { unsigned( instance.size() )    },  // :assign Gnosis` instance ID
+      logger     { logger                         },                                                           // [+] 2026.10.19
       log        { logger.log( title )            },  // :set logging channel
       arena      { Config::gnosis::ARENA_CAPACITY },
       CONGENITAL {                                },
@@ -629,6 +974,7 @@ namespace CoreAGI {
       RUN        { ID                             },
       SEQ        { ID                             },
       SEQUENCE   { ID                             },
+      SPAN       { ID                             },    // [+] 2026.10.19
       STRING     { ID                             },
       SUM        { ID                             },
       SWAP       { ID                             },
@@ -705,6 +1051,7 @@ namespace CoreAGI {
       CONGENITAL.push_back( RUN       =  4527056 );
       CONGENITAL.push_back( SEQ       =   532165 );
       CONGENITAL.push_back( SEQUENCE  =  2215104 );
+      CONGENITAL.push_back( SPAN      =  9412733 ); // [+] 2026.10.19
       CONGENITAL.push_back( STRING    =  5853461 );
       CONGENITAL.push_back( SUM       =  3491838 );
       CONGENITAL.push_back( SWAP      = 15599439 );
@@ -716,6 +1063,7 @@ namespace CoreAGI {
                           27ON   556209  2021.04.29 PROPER
                           fC1z  4087907  2021.04.29 ADJECTIVE
                           8UbP  2327283  2012.06.03 NAME
+                          4tQe  9412733  2026.10.19 SPAN
 
       More: see 'CoreAGI/.backyard/random-id.txt
 
@@ -786,6 +1134,7 @@ namespace CoreAGI {
       expo( "RUN",       RUN       );
       expo( "SEQ",       SEQ       );
       expo( "SEQUENCE",  SEQUENCE  );
+      expo( "SPAN",      SPAN      );  // [+] 2026.10.19
       expo( "STRING",    STRING    );
       expo( "SUM",       SUM       );
       expo( "SWAP",      SWAP      );
@@ -807,6 +1156,12 @@ namespace CoreAGI {
    ~Gnosis(){
       log.vital();
       log( kit( "%s going to finish", TITLE ) );
+      { // Finish background checkpointing:                                                                    // [+] 2026.10.19
+        std::lock_guard< std::mutex > lock( background.mutex );
+        background.stop = true;
+        background.wake.notify_one();
+      }
+      if( background.thread.joinable() ) background.thread.join();
       log( kit( "%s idle state reached; stop segments...", TITLE ) );
       for( auto& S: segments ) log.sure( S.terminate(), kit( "Segment %s cn`t terminate", S.name() ) );
       log( kit( "%s finished", TITLE ) );
@@ -837,6 +1192,28 @@ namespace CoreAGI {
       return true;
     }
                                                                                                                               /*
+    Include / Exclude ancillary storage saved and loaded with the graph: `image` serializes storage
+    (called under commit lock, so it should not wait for the graph), `load` loads file written from
+    the serialized image; `name` is the file name in the folder of the graph image (see `save(..)`)
+    or suffix of the checkpoint file (see `Manifest`):
+                                                                                                                              */
+    Identity onPersistIncl( const char* name,                                                                  // [+] 2026.10.19
+                            std::function< void( std::vector< uint8_t >& ) > image,
+                            std::function< bool( const char* path ) >        load ){
+      for(;;){
+        const Identity key = randomNumber();
+        if( onPersist.contains( key ) ) continue;
+        onPersist.insert_or_assign( key, Persist{ name, image, load } );
+        return key;
+      }
+    }
+
+    bool onPersistExcl( const Identity& key ){                                                                 // [+] 2026.10.19
+      if( not onPersist.contains( key ) ) return false;
+      onPersist.erase( key );
+      return true;
+    }
+                                                                                                                              /*
     List of all congenital concepts:
                                                                                                                               */
     const std::vector< Entity >& congenital() const { return CONGENITAL; }
@@ -851,8 +1228,192 @@ namespace CoreAGI {
       for( const auto& segment: segments ) segment.process( data, f );
     }
 
-    bool save( const char* folder ) const {
+    void freeze( Shard::Frozen* frozen, const Journal* journal = nullptr, uint64_t* fence = nullptr,           // [+] 2026.10.19
+                 std::vector< Annex >* annexes = nullptr ) const {
+                                                                                                                              /*
+      Frozen images of all segments; never contain part of the batch. Batches are journaled
+      under the same lock, so `fence` is LSN of the last batch contained in the images.
+      With `annexes` ancillary storages serialized under the same lock too, so their images
+      match the frozen graph; files written out of the lock (see `writeAnnexes(..)`):
+                                                                                                                              */
+      std::lock_guard< std::mutex > lock( commitMutex );
+      for( unsigned i = 0; i < NUMBER_OF_SEGMENTS; i++ ) frozen[i] = segments[i].freeze();
+      if( fence ) *fence = journal ? journal->lsn() : 0;
+      if( not annexes ) return;
+      annexes->clear();
+      for( const auto& [ key, P ]: onPersist ){
+        annexes->push_back( Annex{ P.name, {} } );
+        P.image( annexes->back().bytes );
+      }
+    }
+
+    static bool writeAnnexes( const std::filesystem::path& dir, const std::string& prefix,                     // [+] 2026.10.19
+                              const std::vector< Annex >& annexes, const Logger::Log& log ){
+                                                                                                                              /*
+      Write images of ancillary storages as `<prefix><name>`; temporary file renamed after written,
+      so existing image is never damaged; `log` is the channel of the calling thread:
+                                                                                                                              */
+      namespace fs = std::filesystem;
+      bool ok{ true };
+      for( const auto& A: annexes ){
+        const fs::path path{ dir/fs::path( prefix + A.name ) };
+        const fs::path pathTemp{ path.string() + "~" };
+        FILE* out = fopen( pathTemp.string().c_str(), "wb" );
+        bool done = out and fwrite( A.bytes.data(), 1, A.bytes.size(), out ) == A.bytes.size();
+        done = out and ( fflush( out ) == 0 ) and done;
+        done = done and ( fsync( fileno( out ) ) == 0 );
+        if( out ) done = ( fclose( out ) == 0 ) and done;
+        std::error_code error;
+        if( done ) fs::rename( pathTemp, path, error );
+        if( not done or error ){
+          log( kit( "Can`t write `%s`", path.string().c_str() ) );
+          fs::remove( pathTemp, error );
+          ok = false;
+        }
+      }
+      return ok;
+    }
+
+    bool loadAnnexes( const std::filesystem::path& dir, const std::string& prefix ){                           // [+] 2026.10.19
+                                                                                                                              /*
+      Load images of ancillary storages written by `writeAnnexes(..)`; missing image is not an error
+      (storage was not included when the graph saved):
+                                                                                                                              */
+      bool ok{ true };
+      for( const auto& [ key, P ]: onPersist ){
+        const std::filesystem::path path{ dir/std::filesystem::path( prefix + P.name ) };
+        if( std::filesystem::exists( path ) ) ok = P.load( path.string().c_str() ) and ok;
+      }
+      return ok;
+    }
+
+    bool write( const std::filesystem::path& path, Layout layout,                                              // [+] 2026.10.19
+                const Shard::Frozen* frozen, const Shard::Frozen* base = nullptr, uint64_t* bytes = nullptr,
+                unsigned bandwidth = 0, const Logger::Log* channel = nullptr ) const {                         // [m] 2026.10.19
+                                                                                                                              /*
+      Write binary image of frozen segments (see `restore(..)` for file format); DELTA layout
+      contains changes since `base` only. Sections encoded and written in parallel, one thread
+      per segment. Limited `bandwidth` (MB/sec) used for background writing: sections processed
+      by the calling thread only and written by chunks paced to the bandwidth. Thread other
+      than the owner of the Gnosis uses own logging `channel`:
+                                                                                                                              */
+      namespace fs = std::filesystem;
+      const Logger::Log& log{ channel ? *channel : this->log };                                               // [+] 2026.10.19
+      assert( layout != DELTA or base );
+      const fs::path pathTemp{ path.string() + "~" };
+      Timer timer;
+      std::vector< uint8_t >  data   [ NUMBER_OF_SEGMENTS ]; // :packed section or head of verbatim one
+      std::vector< unsigned > changed[ NUMBER_OF_SEGMENTS ]; // :pages of DELTA section
+      ImageSection            table  [ NUMBER_OF_SEGMENTS ];
+      constexpr uint64_t PAGE_SIZE{ sizeof( Shard::Entry )*Shard::pageCapacity() };
+      auto each = [&]( auto job ){                                                                             // [+] 2026.10.19
+        if( bandwidth ) for( unsigned s = 0; s < NUMBER_OF_SEGMENTS; s++ ) job( s );
+        else            parallel( job );
+      };
+      each( [&]( unsigned i ){                                                                                 // [m] 2026.10.19
+        table[i].layout = layout;
+        if( layout == PACKED ){
+          table[i].syndromes = Shard::image( frozen[i], data[i], table[i].sequences );
+          table[i].size      = data[i].size();
+        } else {
+          if( layout == VERBATIM ) Shard::verbatim( frozen[i], data[i], table[i].sequences );
+          else                     Shard::delta( frozen[i], base[i], data[i], changed[i], table[i].sequences );
+          Shard::Verbatim V;
+          memcpy( &V, data[i].data(), sizeof( V ) );
+          const uint64_t pages{ layout == VERBATIM ? V.pages : changed[i].size() };
+          table[i].syndromes = V.cardinal;
+          table[i].size      = V.data + pages*PAGE_SIZE;
+        }
+        table[i].crc = crc32( data[i].data(), data[i].size() );
+      });
+      unsigned Ns    { 0                                     };
+      unsigned Nq    { 0                                     };
+      uint64_t offset{ sizeof( ImageHeader ) + sizeof( table ) };
+      for( unsigned i = 0; i < NUMBER_OF_SEGMENTS; i++ ){
+        if( layout != PACKED ){ // Section aligned so mapped pages are aligned as well:
+          offset = ( offset + Shard::ALIGNMENT - 1 )/Shard::ALIGNMENT*Shard::ALIGNMENT;
+        }
+        table[i].offset = offset;
+        offset += table[i].size;
+        Ns     += table[i].syndromes;
+        Nq     += table[i].sequences;
+      }
+      ImageHeader header{};
+      memcpy( header.magic, IMAGE_MAGIC, sizeof( header.magic ) );
+      header.version  = IMAGE_VERSION;
+      header.endian   = IMAGE_ENDIAN;
+      header.segments = NUMBER_OF_SEGMENTS;
+      header.capacity = CAPACITY_OF_SEGMENT;
+      header.syndrome = CAPACITY_OF_SYNDROME;
+      header.crc      = crc32( table, sizeof( table ) );
+                                                                                                                              /*
+      Write into temporary file then rename it, so existing image is never damaged; each
+      section written at its own offset, gaps between sections are read as zeros:
+                                                                                                                              */
+      const int out{ ::open( pathTemp.string().c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644 ) };
+      if( out < 0 ){
+        log( kit( "Can`t create `%s`", pathTemp.string().c_str() ) );
+        return false;
+      }
+      constexpr size_t CHUNK{ 1024*1024 };                 // :of the paced writing                             // [+] 2026.10.19
+      const double     rate { bandwidth*1048.576         }; // :bytes per millisec
+      uint64_t         paced{ 0                          }; // :bytes written by paced writing
+      Timer            pace;
+      auto put = [&]( const void* p, size_t n, uint64_t at )->bool{                                            // [m] 2026.10.19
+        const uint8_t* b{ static_cast< const uint8_t* >( p ) };
+        while( n > 0 ){
+          const ssize_t k{ pwrite( out, b, bandwidth ? std::min( n, CHUNK ) : n, off_t( at ) ) };
+          if( k < 0 and errno == EINTR ) continue;
+          if( k <= 0 ) return false;
+          b += k; n -= size_t( k ); at += uint64_t( k );
+          if( bandwidth ){ // Sleep while ahead of the bandwidth:
+            paced += uint64_t( k );
+            const double ahead{ paced/rate - pace.elapsed( Timer::MILLISEC ) };
+            if( ahead > 1.0 ) std::this_thread::sleep_for( std::chrono::microseconds( int64_t( ahead*1000.0 ) ) );
+          }
+        }
+        return true;
+      };
+      bool ok = put( &header, sizeof( header ), 0 ) and put( table, sizeof( table ), sizeof( header ) );
+      bool done[ NUMBER_OF_SEGMENTS ]{};
+      each( [&]( unsigned i ){                                                                                 // [m] 2026.10.19
+        done[i] = put( data[i].data(), data[i].size(), table[i].offset );
+        if( layout == PACKED ) return;
+        Shard::Verbatim V;
+        memcpy( &V, data[i].data(), sizeof( V ) );
+        uint64_t at{ table[i].offset + V.data };
+        auto page = [&]( unsigned p ){
+          if( not done[i] ) return;
+          done[i] = put( frozen[i].syndromes.pageData( p ), PAGE_SIZE, at );
+          at += PAGE_SIZE;
+        };
+        if( layout == DELTA ) for( const auto p: changed[i] ) page( p );
+        else for( unsigned p = 0; p < Shard::pageCount(); p++ ) if( frozen[i].syndromes.pageData( p ) ) page( p );
+      });
+      for( const bool d: done ) ok = ok and d;
+      ok = ok and ftruncate( out, off_t( offset ) ) == 0; // :trailing gap if any
+      ok = ok and fsync( out ) == 0;
+      ::close( out );
+      std::error_code error;
+      if( ok ) fs::rename( pathTemp, path, error );
+      if( not ok or error ){
+        log( kit( "Can`t write `%s`", path.string().c_str() ) );
+        fs::remove( pathTemp, error );
+        return false;
+      }
+      if( bytes ) *bytes = offset;
+      log( kit( "  Stored %u syndromes and %u sequences (%lu bytes) in %.3f msec",
+                Ns, Nq, offset, timer.elapsed( Timer::MILLISEC ) ) );
+      return true;
+    }
+
+    bool save( const char* folder, Layout layout = PACKED ) const {                                            // [m] 2026.10.19
+                                                                                                                              /*
+      Save binary image of the graph (see `write(..)`); VERBATIM layout is a few times
+      larger but loaded without decoding (see `Segment.adopt(..)`):
+                                                                                                                              */
       log( kit( "Save %s into the `%s` folder", TITLE, folder ) );
+      assert( layout != DELTA );
       namespace fs = std::filesystem;
       fs::path dir{ folder };
       if( not fs::exists( folder ) ){ // Create folder:
@@ -861,28 +1422,254 @@ namespace CoreAGI {
           return false;
         }
       }
-      fs::path syndromes    { SYNDROMES     };
-      fs::path sequences    { SEQUENCES     };
-      fs::path pathSyndromes{ dir/syndromes };
-      fs::path pathSequences{ dir/sequences };
+      Shard::Frozen        frozen[ NUMBER_OF_SEGMENTS ];                                                       // [m] 2026.10.19
+      std::vector< Annex > annexes;                                                                            // [+] 2026.10.19
+      freeze( frozen, nullptr, nullptr, &annexes );                                                            // [m] 2026.10.19
+      return write( dir/fs::path( IMAGE ), layout, frozen ) and writeAnnexes( dir, "", annexes, log );         // [m] 2026.10.19
+    }
+
+  private:
+
+    bool writeCheckpoint( const char* folder, const Shard::Frozen* frozen, const std::vector< Annex >& annexes, // [+] 2026.10.19
+                          uint64_t fence, unsigned bandwidth, const Logger::Log& log ){
+                                                                                                                              /*
+      Incremental checkpoint: the first checkpoint into `folder` writes VERBATIM base image,
+      next ones write deltas with pages and sequence buckets changed since previous checkpoint.
+      Changed ones found by comparing frozen images (shared page is never modified in place),
+      so tracking costs nothing until checkpoint. Manifest replaced after the delta and images
+      of ancillary storages written, so crash never leaves broken chain or images that do not
+      match the graph. After CHECKPOINT_DELTAS deltas (or when deltas become
+      larger than half of the base) chain compacted: new base written under next generation
+      and files of the previous one removed. `log` is the channel of the calling thread:
+                                                                                                                              */
+      namespace fs = std::filesystem;
+      std::lock_guard< std::mutex > lock( checkpointMutex );
+      log( kit( "Checkpoint %s into the `%s` folder", TITLE, folder ) );
+      const fs::path dir     { folder                        };
+      const fs::path manifest{ dir/fs::path( CHECKPOINT )    };
+      std::error_code error;
+      fs::create_directories( dir, error );
+      Checkpoint& C{ checkpointed };
+      const bool compact{
+        C.folder != dir.string() or C.deltas >= CHECKPOINT_DELTAS or C.deltaBytes > C.baseBytes/2
+      };
+      uint64_t bytes{ 0 };
+      if( compact ){
+        Manifest M{};
+        uint32_t generation{ C.folder == dir.string() ? C.generation + 1 : 1 };
+        if( readManifest( manifest, M ) and M.generation >= generation ) generation = M.generation + 1;
+        if( not write( checkpointFile( dir, generation, 0 ), VERBATIM, frozen, nullptr, &bytes, bandwidth, &log ) ) return false;
+        if( not writeAnnexes( dir, annexPrefix( generation, 0 ), annexes, log ) ) return false;                // [+] 2026.10.19
+        if( not writeManifest( manifest, generation, 0, fence, log ) ) return false;
+                                                                                                                              /*
+        Remove files of previous generations (pages mapped from them stay valid):
+                                                                                                                              */
+        const std::string stem{ std::string( CHECKPOINT ) + "." };
+        const std::string mine{ stem + std::to_string( generation ) + "." };
+        for( const auto& entry: fs::directory_iterator( dir, error ) ){
+          const std::string name{ entry.path().filename().string() };
+          if( name.starts_with( stem ) and not name.starts_with( mine ) ) fs::remove( entry.path(), error );
+        }
+        C.folder     = dir.string();
+        C.generation = generation;
+        C.deltas     = 0;
+        C.baseBytes  = bytes;
+        C.deltaBytes = 0;
+      } else {
+        const uint32_t k{ C.deltas + 1 };
+        if( not write( checkpointFile( dir, C.generation, k ), DELTA, frozen, C.frozen, &bytes, bandwidth, &log ) ) return false;
+        if( not writeAnnexes( dir, annexPrefix( C.generation, k ), annexes, log ) ) return false;              // [+] 2026.10.19
+        if( not writeManifest( manifest, C.generation, k, fence, log ) ) return false;
+        for( const auto& A: annexes ){ // :images of the previous checkpoint not referred anymore              // [+] 2026.10.19
+          fs::remove( dir/fs::path( annexPrefix( C.generation, C.deltas ) + A.name ), error );
+        }
+        C.deltas      = k;
+        C.deltaBytes += bytes;
+      }
+      C.fence = fence;
+      for( unsigned i = 0; i < NUMBER_OF_SEGMENTS; i++ ) C.frozen[i] = frozen[i];
+      return true;
+    }
+
+    static void checkpointer( Gnosis* G ){                                                                     // [+] 2026.10.19
+                                                                                                                              /*
+      Thread function of the background checkpointing; posted request written before stop:
+                                                                                                                              */
+      char name[ Config::logger::CHANNEL_NAME_CAPACITY ];
+      snprintf( name, Config::logger::CHANNEL_NAME_CAPACITY - 1, "%s:ckp", G->TITLE );
+      const Logger::Log log{ G->logger.log( name ) };
+      Background& B{ G->background };
+      std::unique_lock< std::mutex > lock( B.mutex );
+      for(;;){
+        B.wake.wait( lock, [&]{ return B.stop or B.frozen; } );
+        if( not B.frozen ) return;
+        const std::unique_ptr< Shard::Frozen[] > frozen{ std::move( B.frozen ) };
+        const std::vector< Annex >               annexes{ std::move( B.annexes ) };                            // [+] 2026.10.19
+        const std::string                        folder{ B.folder            };
+        const uint64_t                           fence { B.fence             };
+        const unsigned                           rate  { B.bandwidth         };
+        B.busy = true;
+        lock.unlock();
+        const bool ok{ G->writeCheckpoint( folder.c_str(), frozen.get(), annexes, fence, rate, log ) };        // [m] 2026.10.19
+        lock.lock();
+        B.busy = false;
+        B.ok   = ok;
+        B.idle.notify_all();
+      }
+    }
+
+  public:
+
+    bool checkpoint( const char* folder, const Journal* journal = nullptr ){                                   // [m] 2026.10.19
+                                                                                                                              /*
+      Incremental checkpoint (see `writeCheckpoint(..)`) written by the calling thread;
+      manifest keeps LSN of the last journaled batch contained in the checkpoint. Posted
+      background checkpoint written first, and no request posted until this one written,
+      so checkpoints never written out of order:
+                                                                                                                              */
+      Background& B{ background };                                                                             // [+] 2026.10.19
+      std::unique_lock< std::mutex > lock( B.mutex );                                                          // [+] 2026.10.19
+      B.idle.wait( lock, [&]{ return not B.busy and not B.frozen; } );                                         // [+] 2026.10.19
+      Shard::Frozen        frozen[ NUMBER_OF_SEGMENTS ];
+      std::vector< Annex > annexes;                                                                            // [+] 2026.10.19
+      uint64_t             fence{ 0 };
+      freeze( frozen, journal, &fence, &annexes );                                                             // [m] 2026.10.19
+      return writeCheckpoint( folder, frozen, annexes, fence, 0, log );                                        // [m] 2026.10.19
+    }
+
+    bool checkpointInBackground( const char* folder, const Journal* journal = nullptr,                         // [+] 2026.10.19
+                                 unsigned bandwidth = CHECKPOINT_BANDWIDTH ){
+                                                                                                                              /*
+      Post incremental checkpoint and return at once. Frozen images taken by the calling thread
+      (as cheap as a snapshot), then the dedicated thread writes them with limited `bandwidth`
+      (MB/sec, 0 means unlimited) while the graph stays available for reading and modification.
+      Request posted while the previous one waits replaces it; `waitCheckpoint()` returns result.
+      Ancillary storages serialized with freezing and their images written by the dedicated thread
+      too; request frozen under the lock of the background, so requests are never reordered:
+                                                                                                                              */
+      Background& B{ background };
+      std::lock_guard< std::mutex > lock( B.mutex );
+      if( B.stop ) return false;
+      std::unique_ptr< Shard::Frozen[] > frozen{ std::make_unique< Shard::Frozen[] >( NUMBER_OF_SEGMENTS ) };
+      std::vector< Annex >               annexes;                                                              // [+] 2026.10.19
+      uint64_t                           fence{ 0 };
+      freeze( frozen.get(), journal, &fence, &annexes );                                                       // [m] 2026.10.19
+      if( not B.thread.joinable() ) B.thread = std::thread( checkpointer, this );
+      B.folder    = folder;
+      B.frozen    = std::move( frozen );
+      B.annexes   = std::move( annexes );                                                                      // [+] 2026.10.19
+      B.fence     = fence;
+      B.bandwidth = bandwidth;
+      B.wake.notify_one();
+      return true;
+    }
+
+    bool checkpointing(){                                                                                      // [+] 2026.10.19
+      std::lock_guard< std::mutex > lock( background.mutex );
+      return background.busy or background.frozen;
+    }
+
+    bool waitCheckpoint(){                                                                                     // [+] 2026.10.19
+                                                                                                                              /*
+      Wait until background checkpoint finished; returns its result:
+                                                                                                                              */
+      std::unique_lock< std::mutex > lock( background.mutex );
+      background.idle.wait( lock, [&]{ return not background.busy and not background.frozen; } );
+      return background.ok;
+    }
+
+    uint64_t checkpointFence(){                                                                                // [+] 2026.10.19
+                                                                                                                              /*
+      LSN of the last journaled batch contained in the last written or restored checkpoint;
+      journal frames after it should be replayed over restored checkpoint (see `Batch::replay(..)`):
+                                                                                                                              */
+      std::lock_guard< std::mutex > lock( checkpointMutex );
+      return checkpointed.fence;
+    }
+
+    bool restoreCheckpoint( const char* folder ){                                                              // [+] 2026.10.19
+                                                                                                                              /*
+      Load base image and apply deltas listed in the manifest (see `checkpoint(..)`);
+      next checkpoint into the same folder continues the chain. The graph unchanged if
+      any image of the chain rejected:
+                                                                                                                              */
+      namespace fs = std::filesystem;
+      std::lock_guard< std::mutex > lock( checkpointMutex );
+      const fs::path dir{ folder };
+      Checkpoint& C{ checkpointed };
+      C = Checkpoint{};
+      Manifest M;
+      if( not readManifest( dir/fs::path( CHECKPOINT ), M ) ){
+        log( kit( "  Manifest of checkpoints in `%s` not found or damaged", folder ) );
+        return false;
+      }
+      std::error_code error;
+      uint64_t deltaBytes{ 0 };
+      std::vector< Shard::Frozen > origin( NUMBER_OF_SEGMENTS );                                               // [+] 2026.10.19
+      freeze( origin.data() );
+      bool ok{ restore( checkpointFile( dir, M.generation, 0 ).string().c_str() ) };
+      for( uint32_t k = 1; ok and k <= M.deltas; k++ ){
+        const fs::path path{ checkpointFile( dir, M.generation, k ) };
+        ok = restore( path.string().c_str(), true );
+        deltaBytes += fs::file_size( path, error );
+      }
+      ok = ok and loadAnnexes( dir, annexPrefix( M.generation, M.deltas ) ); // :images of the same checkpoint // [+] 2026.10.19
+      if( not ok ){ // :chain restored partially or ancillary image rejected                                   // [+] 2026.10.19
+        thaw( origin.data() );
+        return false;
+      }
+      C.folder     = dir.string();
+      C.generation = M.generation;
+      C.deltas     = M.deltas;
+      C.baseBytes  = fs::file_size( checkpointFile( dir, M.generation, 0 ), error );
+      C.deltaBytes = deltaBytes;
+      C.fence      = M.fence;
+      freeze( C.frozen );
+      return true;
+    }
+
+    bool saveText( const char* folder ) const {                                                                // [+] 2026.10.19
+                                                                                                                              /*
+      Save graph in the textual form (see `load(..)`), that is suitable for diff and debugging;
+      `load(..)` prefers binary image, so the image should be removed from the folder to load text:
+                                                                                                                              */
+      log( kit( "Save %s as text into the `%s` folder", TITLE, folder ) );
+      namespace fs = std::filesystem;
+      fs::path dir{ folder };
+      std::error_code error;
+      fs::create_directories( dir, error );
+      const fs::path pathSyndromes{ dir/fs::path( SYNDROMES ) };
+      const fs::path pathSequences{ dir/fs::path( SEQUENCES ) };
+      Timer timer;
+      Shard::Frozen frozen[ NUMBER_OF_SEGMENTS ];
+      freeze( frozen );
       FILE* fileSyndromes = fopen( pathSyndromes.string().c_str(), "w" );
       FILE* fileSequences = fopen( pathSequences.string().c_str(), "w" );
-      if( not fileSyndromes or not fileSequences ) return false;
+      bool  ok{ fileSyndromes and fileSequences };
       unsigned Ns{ 0 };
       unsigned Nq{ 0 };
-      for( auto& segment: segments ){
-        Ns += segment.saveSyndromes( fileSyndromes );
-        Nq += segment.saveSequences( fileSequences );
+      if( ok ){
+        EncodedWriter outSyndromes( fileSyndromes );
+        EncodedWriter outSequences( fileSequences );
+        for( const auto& F: frozen ){
+          Ns += Shard::saveSyndromes( F, outSyndromes );
+          Nq += Shard::saveSequences( F, outSequences );
+        }
+        ok = outSyndromes.flush() and outSequences.flush();
       }
-      fclose( fileSyndromes );
-      fclose( fileSequences );
-      log( kit( "  Stored %u syndromes and %u sequences", Ns, Nq ) );
+      if( fileSyndromes ) ok = ( fclose( fileSyndromes ) == 0 ) and ok;
+      if( fileSequences ) ok = ( fclose( fileSequences ) == 0 ) and ok;
+      if( not ok ){
+        log( kit( "Can`t write text files into `%s`", folder ) );
+        return false;
+      }
+      log( kit( "  Stored %u syndromes and %u sequences in %.3f msec", Ns, Nq, timer.elapsed( Timer::MILLISEC ) ) );
       return true;
     }
 
     bool load( const char* folder ){
                                                                                                                               /*
-      File format:
+      Legacy textual file format:                                                                              // [m] 2026.10.19
 
       [1] Each line defines single entity
       [2] Encoded Entity ID followed by encoded signs ID or sequence elements ID
@@ -896,6 +1683,30 @@ namespace CoreAGI {
         log( kit( "Folder `%s` not found", std::string( folder ).c_str() ) );
         return false;
       }
+      fs::path pathImage{ dir/fs::path( IMAGE ) };                                                             // [+] 2026.10.19
+      fs::path pathChain{ dir/fs::path( CHECKPOINT ) };                                                        // [+] 2026.10.19
+      std::error_code error;
+      if( fs::exists( pathChain ) and ( not fs::exists( pathImage ) or
+          fs::last_write_time( pathChain, error ) >= fs::last_write_time( pathImage, error ) ) ){
+        if( restoreCheckpoint( folder ) ) return true; // :checkpoint is newer than full image; ancillary images too // [m] 2026.10.19
+        if( not fs::exists( pathImage ) ) return false;                                                        // [+] 2026.10.19
+        log( kit( "  Checkpoint rejected, full image `%s` loaded instead", pathImage.string().c_str() ) );     // [+] 2026.10.19
+      }
+      {
+        std::lock_guard< std::mutex > lock( checkpointMutex );
+        checkpointed = Checkpoint{}; // :next checkpoint starts new chain
+      }
+      if( fs::exists( pathImage ) ){ // Graph kept if graph image or any ancillary image rejected:             // [m] 2026.10.19
+        std::vector< Shard::Frozen > origin( NUMBER_OF_SEGMENTS );
+        freeze( origin.data() );
+        if( not restore( pathImage.string().c_str() ) ) return false;
+        if( loadAnnexes( dir, "" ) ) return true;
+        thaw( origin.data() );
+        return false;
+      }
+                                                                                                                              /*
+      Binary image not found, so load graph saved in textual form by previous versions:
+                                                                                                                              */
                                                                                                                               /*
       Check file presence:
                                                                                                                               */
@@ -923,35 +1734,47 @@ namespace CoreAGI {
       for( unsigned i = 0; i < NUMBER_OF_SEGMENTS; i++ ) segments[i].clear();
       log.vital( "  Segments cleared.." ); log.flush();
       Signs syndrome{};
-      auto  addSign = [&]( Identity ID ){ syndrome.incl( ID ); };
       Timer timer;
       unsigned num{ 0 };
-      for(;;){
-        syndrome.clear();
-        const Identity EntityId = readAndDecode( addSign, fileSyndromes );
+      std::vector< Identity > ids;                                                                             // [m] 2026.10.19
+      EncodedReader readerSyndromes( fileSyndromes );
+      while( readerSyndromes.line( ids ) ){
+        const Identity EntityId{ ids.front() };
         if( not EntityId ) break;
+        syndrome.clear();
+        for( size_t i = 1; i < ids.size(); i++ ) syndrome.incl( ids[i] );
         Shard& shard{ segment( EntityId ) };
         shard.incl( EntityId, syndrome );
         num++;
       }
       fclose( fileSyndromes );
+      if( not readerSyndromes.good() ){
+        log( kit( "  Malformed file `%s`", std::string( pathSyndromes ).c_str() ) );
+        fclose( fileSequences );
+        return false;
+      }
       log( kit( "  Graph with %u nodes loaded in %.3f msec", num, timer.elapsed( Timer::MILLISEC ) ) );
                                                                                                                               /*
       Load sequences:
                                                                                                                               */
       log( kit( "  Load sequences from `%s`..", std::string( pathSyndromes ).c_str() ) );
       Seq  seq{};
-      auto addElem = [&]( Identity ID ){ seq.append( ID ); };
       timer.start();
-      for(;;){
-        seq.clear();
-        const Identity entityId = readAndDecode( addElem, fileSequences );
+      EncodedReader readerSequences( fileSequences );                                                          // [m] 2026.10.19
+      while( readerSequences.line( ids ) ){
+        const Identity entityId{ ids.front() };
         if( not entityId ) break;
+        seq.clear();
+        for( size_t i = 1; i < ids.size(); i++ ) seq.append( ids[i] );
         log.sure( exist( entityId ), kit( "Sequence of the non-existing entity `%u`", entityId ) );
         Shard& shard{ segment( entityId ) };
         shard.seq( entityId, seq );
       }
       fclose( fileSequences );
+      if( not readerSequences.good() ){
+        log( kit( "  Malformed file `%s`", std::string( pathSequences ).c_str() ) );
+        return false;
+      }
       log( kit( "  Sequences loaded in %.3f msec", timer.elapsed( Timer::MILLISEC ) ) );
       return true;
     }
@@ -1246,6 +2069,120 @@ namespace CoreAGI {
       for( const auto& elem: E ) Q.append( elem );
       return Q;
     }
+                                                                                                                              /*
+    Snapshot is an inner class of the Gnosis that represents immutable image of the knowledge
+    graph taken at some moment (multi-version concurrency control). Creation of the snapshot
+    costs copying of the segments` page tables only: pages are shared with the live graph
+    until modified (copy-on-write, see `Flat::MapView`), so long-running queries can work with
+    consistent state of the graph while the graph is modified. Snapshot is read-only, so it
+    can be used from a few threads simultaneously.
+
+    NB: snapshot must be created by the thread that modifies the graph (or when the graph
+        is not modified by other threads).
+                                                                                                                              */
+    class Snapshot: public Local {                                                                             // [+] 2026.10.19
+
+      friend class Gnosis;
+
+      uint64_t      VERSION;                       // :version of the graph at the moment of the snapshot
+      Shard::Frozen frozen[ NUMBER_OF_SEGMENTS ];  // :images of the segments
+
+      Snapshot( unsigned unit ): Local( unit ), VERSION{ 0 }, frozen{}{}
+
+      const Shard::Frozen& segment( Identity i ) const { return frozen[ i % NUMBER_OF_SEGMENTS ]; }
+
+      const Signs* S_( const Identity& id ) const { return segment( id ).syndromes[ id ];            }
+      const Seq*   Q_( const Identity& id ) const { return Shard::Q( segment( id ).sequences, id ); }
+
+      Entity entity( Identity id ) const {
+                                                                                                                              /*
+        Reconstruction of the entity that exists in the snapshot (maybe forgotten since):
+                                                                                                                              */
+        Entity e{ unit }; // :private constructor
+        e.id = id;
+        return e;
+      }
+
+    public:
+
+      uint64_t version() const { return VERSION; }
+
+      size_t size() const {
+        size_t total{ 0 };
+        for( const auto& F: frozen ) total += F.syndromes.size();
+        return total;
+      }
+
+      bool exists( Identity id ) const { return segment( id ).syndromes.contains( id ); }
+
+      bool is( const Entity& e, const Entity& sign ) const {
+        if( sign.id == CoreAGI::NIHIL         ) return false;
+        if( not mate( e ) or not mate( sign ) ) return false;
+        const Signs* Y{ S_( e.id ) };
+        return Y and Y->contains( sign.id );
+      }
+
+      Syndrome S( const Entity& e ) const {
+        assert( mate( e ) );
+        const Signs* Y{ S_( e.id ) };
+        return Y ? Syndrome{ unit, *Y } : Syndrome{ unit };
+      }
+
+      Sequence Q( const Entity& e ) const {
+        assert( mate( e ) );
+        const Seq* Q{ Q_( e.id ) };
+        return Q ? Sequence{ unit, *Q } : Sequence{ unit };
+      }
+
+      unsigned select( const std::span< Syndrome >& syndrome, std::function< bool( unsigned, const Entity& ) > f ) const {
+                                                                                                                              /*
+        Same as Gnosis.select(..) but over snapshot: segments scanned in parallel by temporary
+        threads, so no segment` service threads involved and no limit of selection size:
+                                                                                                                              */
+        const size_t N{ syndrome.size() };
+        gnosis().log.sure( N > 0, "`select` called with empty array of syndromes" );
+        std::vector< std::vector< Identity > > Y( N );
+        for( size_t i = 0; i < N; i++ ) for( const auto& sign: syndrome[i].syndrome ) Y[i].push_back( sign );
+        std::vector< std::pair< unsigned, Identity > > found[ NUMBER_OF_SEGMENTS ]; // :( syndrome index, ID )
+        auto scan = [&]( unsigned s ){
+          for( const auto& entry: frozen[s].syndromes ){
+            for( size_t i = 0; i < N; i++ ){
+              if( Y[i].size() > entry.val.size() ) continue;
+              if( Y[i].empty() or entry.val.contains( std::span< Identity >( Y[i] ) ) ) found[s].push_back( { i, entry.key } );
+            }
+          }
+        };
+        std::vector< std::thread > T;
+        for( unsigned s = 0; s < NUMBER_OF_SEGMENTS; s++ ) T.push_back( std::thread( scan, s ) );
+        for( auto& Ti: T ) Ti.join();
+        unsigned totalSelected{ 0 };
+        for( const auto& F: found ) for( const auto& [ i, id ]: F ){ f( i, entity( id ) ); totalSelected++; }
+        return totalSelected;
+      }
+
+    };//class Gnosis::Snapshot
+
+    uint64_t version() const {                                                                                 // [+] 2026.10.19
+                                                                                                                              /*
+      Counter of modifications of the graph (sum of the segments` counters):
+                                                                                                                              */
+      uint64_t v{ 0 };
+      for( const auto& S: segments ) v += S.version();
+      return v;
+    }
+
+    Snapshot snapshot() const {                                                                                // [+] 2026.10.19
+                                                                                                                              /*
+      Make immutable image of the current state of the graph:
+                                                                                                                              */
+      std::lock_guard< std::mutex > lock( commitMutex ); // :never take part of batch                          // [+] 2026.10.19
+      Snapshot S{ ID };
+      for( unsigned s = 0; s < NUMBER_OF_SEGMENTS; s++ ){
+        S.frozen[s] = segments[s].freeze();
+        S.VERSION  += S.frozen[s].version;
+      }
+      return S;
+    }
 
                                                                                                                               /*
     SetOfEntities is an inner class of the Gnosis that represents of arbitrary subset of entities.
@@ -1410,6 +2347,23 @@ namespace CoreAGI {
       }//for
       return totalSelected;
 
+    }//select
+                                                                                                                              /*
+    Select among the candidates (sorted or not) entities that have the syndrome; candidates usually
+    produced by value predicate of the data storage (see `Data::Mini::selectIntegers(..)`), so mixed
+    structural and value query checks only the candidates instead of scanning segments; empty
+    syndrome accepts any existing candidate; `f` returns `false` to break selection:
+                                                                                                                              */
+    unsigned select( const Syndrome& syndrome, std::span< const Identity > candidate, std::function< bool( const Entity& ) > f ) const { // [+] 2026.10.19
+      unsigned n{ 0 };
+      for( const Identity id: candidate ){
+        if( id == CoreAGI::NIHIL or not exists( id ) ) continue;
+        const Signs* Y{ S_( id ) };
+        if( not syndrome.empty() and not ( Y and Y->contains( syndrome.syndrome ) ) ) continue;
+        n++;
+        if( not f( recover( id ) ) ) break;
+      }
+      return n;
     }//select
 
     SetOfEntities setOfEntities( const Syndrome& syndrome ) const {
@@ -1507,6 +2461,31 @@ namespace CoreAGI {
       std::function< bool       ( const Sequence& ) > f,
       std::function< std::string( Identity        ) > lex   = nullptr, // :converts ID to string
       const char*                                     trace = nullptr  // :trace file` path
+    ) const {
+      return analogic_( nullptr, pattern, mask, f, lex, trace );                                               // [m] 2026.10.19
+    }
+
+    bool analogic(                                                                                             // [+] 2026.10.19
+      const Snapshot&                                 view,            // :snapshot used instead of live graph
+      const Sequence&                                 pattern,
+      const Syndrome&                                 mask,
+      std::function< bool       ( const Sequence& ) > f,
+      std::function< std::string( Identity        ) > lex   = nullptr, // :converts ID to string
+      const char*                                     trace = nullptr  // :trace file` path
+    ) const {
+      assert( view.unit == ID );
+      return analogic_( &view, pattern, mask, f, lex, trace );
+    }
+
+  private:
+
+    bool analogic_(                                                                                            // [+] 2026.10.19
+      const Snapshot*                                 view,            // :snapshot or nullptr for live graph
+      const Sequence&                                 pattern,
+      const Syndrome&                                 mask,
+      std::function< bool       ( const Sequence& ) > f,
+      std::function< std::string( Identity        ) > lex,
+      const char*                                     trace
     ) const {
                                                                                                                               /*
       Seach for Entity` tuples analogical to provided `origin` tuple
@@ -1521,7 +2500,14 @@ namespace CoreAGI {
       Syndrome has no default constructor, so std::vector used to form array:
                                                                                                                               */
       std::vector< Syndrome > Sx; // :`external` syndromes for each `variable`
-      for( uint8_t i = 0; i < N; i++ ) Sx.push_back( pattern[i].S() );
+      for( uint8_t i = 0; i < N; i++ ) Sx.push_back( view ? view->S( pattern[i] ) : pattern[i].S() );          // [m] 2026.10.19
+                                                                                                                              /*
+      Test of the edge e -> s in the snapshot or live graph:
+                                                                                                                              */
+      auto linked = [&]( const Identity e, const Identity s )->bool{                                           // [+] 2026.10.19
+        const Signs* Y{ view ? view->S_( e ) : S_( e ) };
+        return Y and Y->contains( s );
+      };
                                                                                                                               /*
       Compose mapping local id <-> global id for subgraph nodes and compose array of syndromes
                                                                                                                               */
@@ -1582,19 +2568,19 @@ namespace CoreAGI {
       Fill up lists of candidates - avoid to include pattern element and entities
       with empty syndrome that obviously must be rejected:
                                                                                                                               */
-      select(
-        std::span< Syndrome >( Sx ),
-        [&]( unsigned i, const Entity& e )->bool{
-          if( e.id != node[i].global and not e.S().empty() ) node[i].candidates.push_back( e.id );             // [+] 2021.01.02
-          return true;
-        }
-      );
+      auto candidate = [&]( unsigned i, const Entity& e )->bool{                                               // [m] 2026.10.19
+        const Signs* Y{ view ? view->S_( e.id ) : S_( e.id ) };
+        if( e.id != node[i].global and Y and not Y->empty() ) node[i].candidates.push_back( e.id );            // [+] 2021.01.02
+        return true;
+      };
+      if( view ) view->select( std::span< Syndrome >( Sx ), candidate );                                       // [m] 2026.10.19
+      else             select( std::span< Syndrome >( Sx ), candidate );
                                                                                                                               /*
       Reduce list of candidates in case of self-loop:
                                                                                                                               */
       for( unsigned i = 0; i < N; i++ ){
         const Entity& Ei{ pattern[i] };
-        if( Ei.is( Ei ) ){
+        if( linked( Ei.id, Ei.id ) ){                                                                          // [m] 2026.10.19
                                                                                                                               /*
           Pattern contains self-loop, so candidates must be self-looped to:
                                                                                                                               */
@@ -1602,8 +2588,7 @@ namespace CoreAGI {
           std::vector< Identity > original( Ni.candidates );
           Ni.candidates.clear();
           for( Identity id: original ){
-            Entity e{ recover( id ) };
-            if( e.is( e ) ) Ni.candidates.push_back( e.id );
+            if( linked( id, id ) ) Ni.candidates.push_back( id );                                              // [m] 2026.10.19
             if( lex ) log.vital( kit( "[analogic] Detected loop for %u:%s; set reduced from %u to %u",
                                          i, lex( Ei.id ).c_str(), original.size(), Ni.candidates.size() ) );
             else      log.vital( kit( "[analogic] Detected loop for %u:#%u; set reduced from %u to %u",
@@ -1611,6 +2596,86 @@ namespace CoreAGI {
           }
         }
       }//for i
+                                                                                                                              /*
+      Arc consistency (AC-3): candidate of `from` of the edge that links no candidate of `into`,
+      and candidate of `into` linked from no candidate of `from`, can not be a part of analogy;
+      removal breaks support of other candidates, so revision repeated until no changes. Edges
+      of the round revised in parallel over the same lists, removals applied after the round:
+                                                                                                                              */
+      {                                                                                                        // [+] 2026.10.19
+        struct Arc {
+          uint8_t                from;
+          uint8_t                into;
+          std::vector< uint8_t > keep[ 2 ]; // :supported candidates of `from` and `into`
+        };
+        std::vector< Arc > arc;
+        for( uint8_t i = 0; i < N; i++ ) for( uint8_t j = 0; j < N; j++ ) if( i != j and D[i][j] ) arc.push_back( Arc{ i, j, {} } );
+
+        size_t before{ 0 };
+        for( unsigned i = 0; i < N; i++ ) before += node[i].candidates.size();
+
+        std::vector< Identity > sorted[ CAPACITY ]; // :candidates sorted by ID for search
+        auto revise = [&]( Arc& A ){
+          const Candidates& C{ node[ A.from ].candidates };
+          const auto&       B{ sorted[ A.into ] };
+          A.keep[0].assign( C.size(), 0 );
+          A.keep[1].assign( B.size(), 0 );
+          for( size_t a = 0; a < C.size(); a++ ){
+            const Signs* Y{ view ? view->S_( C[a] ) : S_( C[a] ) };
+            if( Y ) for( const auto& s: *Y ){
+              const auto it{ std::lower_bound( B.begin(), B.end(), s ) };
+              if( it == B.end() or *it != s ) continue;
+              A.keep[0][a] = 1;
+              A.keep[1][ it - B.begin() ] = 1;
+            }
+          }
+        };
+
+        unsigned Nw{ std::thread::hardware_concurrency() };
+        if( Nw == 0 ) Nw = NUMBER_OF_THREADS;
+        Nw = std::min< unsigned >( Nw, arc.size() );
+        unsigned rounds{ 0 };
+        for( bool changed{ not arc.empty() }; changed; rounds++ ){
+          for( unsigned i = 0; i < N; i++ ){
+            sorted[i] = node[i].candidates;
+            std::sort( sorted[i].begin(), sorted[i].end() );
+          }
+          if( Nw > 1 ){
+            std::atomic< size_t >      next{ 0 };
+            std::vector< std::thread > T;
+            for( unsigned t = 0; t < Nw; t++ ) T.push_back( std::thread( [&]{
+              for( size_t k; ( k = next++ ) < arc.size(); ) revise( arc[k] );
+            }));
+            for( auto& Ti: T ) Ti.join();
+          } else {
+            for( Arc& A: arc ) revise( A );
+          }
+                                                                                                                              /*
+          Candidate kept if all arcs of its node support it; lists of `into` marked in ID order:
+                                                                                                                              */
+          changed = false;
+          for( unsigned i = 0; i < N; i++ ){
+            std::vector< uint8_t > keep( node[i].candidates.size(), 1 );
+            std::vector< uint8_t > held( sorted[i].size(), 1 );
+            for( const Arc& A: arc ){
+              if( A.from == i ) for( size_t a = 0; a < keep.size(); a++ ) keep[a] &= A.keep[0][a];
+              if( A.into == i ) for( size_t b = 0; b < held.size(); b++ ) held[b] &= A.keep[1][b];
+            }
+            Candidates& C{ node[i].candidates };
+            Candidates  R;
+            for( size_t a = 0; a < C.size(); a++ ){
+              if( not keep[a] ) continue;
+              const auto it{ std::lower_bound( sorted[i].begin(), sorted[i].end(), C[a] ) };
+              if( held[ it - sorted[i].begin() ] ) R.push_back( C[a] );
+            }
+            if( R.size() < C.size() ){ C.swap( R ); changed = true; }
+          }
+        }
+
+        size_t after{ 0 };
+        for( unsigned i = 0; i < N; i++ ) after += node[i].candidates.size();
+        if( lex ) log.vital( kit( "[analogic] Arc consistency: %u rounds; candidates reduced from %lu to %lu", rounds, before, after ) );
+      }
 
       if( lex ){
         log.vital();
@@ -1892,33 +2957,109 @@ namespace CoreAGI {
         log.flush();
       }//if lex
 
-      std::this_thread::sleep_for( std::chrono::seconds( 1 ) ); // DEBUG
-
       FILE* out = nullptr;
-      int Nt{ NUMBER_OF_THREADS };
+      unsigned Nt{ std::thread::hardware_concurrency() };                                                      // [m] 2026.10.19
+      if( Nt == 0 ) Nt = NUMBER_OF_THREADS; // :hardware concurrency unknown
       if( trace ){
         out = fopen( trace, "w" ); // :for debugging only
         Nt  = 1;
       }
-      std::atomic< size_t > totalTests{ 0 };
                                                                                                                               /*
-      Interpret code:
+      Adjacency of the candidates over each edge of the pattern (CSR): for each candidate of one
+      end - sorted indices of the linked candidates of other end, forward by `from` and backward
+      by `into`; lists are short (bounded by the size of the syndrome for forward direction), so
+      EDGE test is a search in one list, and NODE takes candidates from the shortest list of its
+      assigned neighbours instead of the whole list of candidates:
+                                                                                                                              */
+      struct Adjacency {                                                                                       // [+] 2026.10.19
+        std::vector< uint32_t > head[ 2 ]; // :[0] by candidate of `from`, [1] by candidate of `into`
+        std::vector< uint32_t > next[ 2 ]; // :indices of the candidates of other end
+        std::span< const uint32_t > of( unsigned d, uint32_t a ) const {
+          return std::span< const uint32_t >( next[d].data() + head[d][a], head[d][ a + 1 ] - head[d][a] );
+        }
+      };
+      std::vector< Adjacency > adjacency( Ne );                                                                // [+] 2026.10.19
+      int link[ CAPACITY ][ CAPACITY ]; // :from, into -> edge index, -1 if none
+      {
+        using Position = std::pair< Identity, uint32_t >;
+        std::vector< std::vector< Position > > position( N ); // :candidate -> its index, sorted by ID
+        for( unsigned i = 0; i < N; i++ ){
+          const Candidates& C{ node[i].candidates };
+          for( uint32_t a = 0; a < C.size(); a++ ) position[i].push_back( Position{ C[a], a } );
+          std::sort( position[i].begin(), position[i].end() );
+          for( unsigned j = 0; j < N; j++ ) link[i][j] = -1;
+        }
+        for( unsigned k = 0; k < Ne; k++ ){
+          const Edge&       Ek{ edge[k] };
+          const Candidates& A { node[ Ek.from ].candidates };
+          const auto&       B { position[ Ek.into ] };
+          Adjacency&        J { adjacency[k] };
+          link[ Ek.from ][ Ek.into ] = k;
+          J.head[0].reserve( A.size() + 1 );
+          J.head[0].push_back( 0 );
+          for( const Identity e: A ){
+            const Signs* Y{ view ? view->S_( e ) : S_( e ) };
+            if( Y ) for( const auto& s: *Y ){
+              const auto it{ std::lower_bound( B.begin(), B.end(), Position{ s, 0 } ) };
+              if( it != B.end() and it->first == s ) J.next[0].push_back( it->second );
+            }
+            std::sort( J.next[0].begin() + J.head[0].back(), J.next[0].end() );
+            J.head[0].push_back( J.next[0].size() );
+          }
+                                                                                                                              /*
+          Backward lists by transposition; they are sorted since forward ones visited in order:
                                                                                                                               */
-      auto run = [&]( int Nt, int t ){ // Nt ~ number of threads, t ~ thread index
+          const size_t Nb{ node[ Ek.into ].candidates.size() };
+          J.head[1].assign( Nb + 1, 0 );
+          for( const uint32_t b: J.next[0] ) J.head[1][ b + 1 ]++;
+          for( size_t b = 0; b < Nb; b++ ) J.head[1][ b + 1 ] += J.head[1][b];
+          J.next[1].resize( J.next[0].size() );
+          std::vector< uint32_t > fill( J.head[1].begin(), J.head[1].end() - 1 );
+          for( uint32_t a = 0; a < A.size(); a++ ) for( const uint32_t b: J.of( 0, a ) ) J.next[1][ fill[b]++ ] = a;
+        }
+      }
+                                                                                                                              /*
+      Levels of the search are NODE instructions in order of the code. Frame of the level is the
+      range of untried candidates of its node packed into single word (generation, end, next), so
+      owner takes next candidate and idle worker splits the range by single CAS; generation makes
+      reopened frame distinct from previous one:
+                                                                                                                              */
+      int      at   [ CAPACITY ]; // :level -> code index of the NODE instruction                             // [+] 2026.10.19
+      unsigned level[ CAPACITY ]; // :node  -> level
+      unsigned Nl{ 0 };           // :number of levels
+      for( int i = 0; i < vacant; i++ ) if( code[i].action == NODE ){ level[ code[i].node ] = Nl; at[ Nl++ ] = i; }
+
+      constexpr uint64_t M24{ ( uint64_t( 1 ) << 24 ) - 1 };
+      for( unsigned i = 0; i < N; i++ ) assert( node[i].candidates.size() <= M24 );
+      auto pack = []( uint64_t gen, uint64_t end, uint64_t next ){ return ( gen & 0xFFFF ) << 48 | end << 24 | next; };
 
-        assert( t >= 0 and t < Nt );
+      struct alignas( 64 ) Worker {                                                                            // [+] 2026.10.19
+        std::atomic< uint64_t > range[ CAPACITY ]; // :frames by level
+        std::atomic< uint32_t > pick [ CAPACITY ]; // :indices of assigned candidates by node (read by thieves)
+      };
+      std::vector< Worker >   worker( Nt );
+      std::atomic< unsigned > busy{ Nt    }; // :workers that run task or try to steal
+      std::atomic< bool >     stop{ false }; // :`f` requested to stop search
+                                                                                                                              /*
+      Interpret code:
+                                                                                                                              */
+      auto run = [&]( unsigned t ){ // t ~ worker index                                                       // [m] 2026.10.19
 
         using Bitset = std::bitset < CAPACITY >;
 
+        Worker&  W{ worker[t] };
         Bitset   det;             // :set of currently assigned variables
-        int      len[ CAPACITY ]; // :length  of candidates lists
-        int      num[ CAPACITY ]; // :indices of current candidates
-        Identity var[ CAPACITY ]; // :identities of tested combination
+        Bitset   open;            // :levels with the frame in use                                            // [+] 2026.10.19
+        int             len [ CAPACITY ]; // :length  of candidates lists (of the frame)                       // [m] 2026.10.19
+        int             num [ CAPACITY ]; // :indices of current candidates in the frame
+        uint32_t        pick[ CAPACITY ]; // :indices of current candidates in the lists of node candidates    // [+] 2026.10.19
+        Identity        var [ CAPACITY ]; // :identities of tested combination
+        const uint32_t* list[ CAPACITY ]; // :level -> candidates of the frame, nullptr for all of them        // [+] 2026.10.19
 
         for( unsigned i = 0; i < N; i++ ){
           const int Li = node[i].candidates.size();
           len[i] = Li;                                                                                         // [-] 2021.01.02
-          num[i] = ( i == Eo.from ) ? t - 1 : -1;
+          num[i] = -1;                                                                                         // [m] 2026.10.19
           if( out ){
             fprintf( out, "\n\n %u candidates for %u:%s:", Li, i, lex( node[i].global ).c_str() );
             for( const auto& c: node[i].candidates )
@@ -1926,13 +3067,133 @@ namespace CoreAGI {
           }
         }
 
+        std::vector< uint32_t > meet[ CAPACITY ]; // :level -> intersection of the lists                       // [+] 2026.10.19
+
+        auto source = [&]( unsigned n, unsigned l )->uint32_t{                                                 // [+] 2026.10.19
+                                                                                                                              /*
+          List of the candidates of node `n` for the frame of level `l`: all candidates if there is
+          no assigned neighbour, else the shortest list of candidates linked with them or (generic
+          join) intersection of all such lists. Depends only on assignment of the upper levels, so
+          thief gets the same list as owner of the frame:
+                                                                                                                              */
+          std::span< const uint32_t > S[ 2*CAPACITY ];
+          unsigned Ns{ 0 };
+          for( unsigned m = 0; m < N; m++ ){
+            if( m == n or not det[m] ) continue;
+            if( link[m][n] >= 0 ) S[ Ns++ ] = adjacency[ link[m][n] ].of( 0, pick[m] );
+            if( link[n][m] >= 0 ) S[ Ns++ ] = adjacency[ link[n][m] ].of( 1, pick[m] );
+          }
+          if( Ns == 0 ){
+            list[l] = nullptr;
+            return node[n].candidates.size();
+          }
+          std::sort( S, S + Ns, []( const auto& a, const auto& b ){ return a.size() < b.size(); } );
+          if( Ns == 1 or not ANALOGIC_JOIN ){
+            list[l] = S[0].data();
+            return S[0].size();
+          }
+                                                                                                                              /*
+          Shortest list drives, other ones seek forward to its values (leapfrog):
+                                                                                                                              */
+          std::vector< uint32_t >& R{ meet[l] };
+          R.clear();
+          const uint32_t* seek[ 2*CAPACITY ];
+          for( unsigned j = 1; j < Ns; j++ ) seek[j] = S[j].data();
+          for( const uint32_t x: S[0] ){
+            unsigned j{ 1 };
+            for( ; j < Ns; j++ ){
+              seek[j] = std::lower_bound( seek[j], S[j].data() + S[j].size(), x );
+              if( seek[j] == S[j].data() + S[j].size() or *seek[j] != x ) break;
+            }
+            if( j == Ns ) R.push_back( x );
+            else if( seek[j] == S[j].data() + S[j].size() ) break; // :no more common values
+          }
+          list[l] = R.data();
+          return R.size();
+        };
+
+        auto adjacent = [&]( unsigned from, unsigned into )->bool{                                             // [+] 2026.10.19
+          const int k{ link[ from ][ into ] };
+          if( k < 0 ) return linked( var[ from ], var[ into ] );
+          if( ANALOGIC_JOIN ) return true; // :candidate taken from intersection of the lists of all neighbours
+          const auto S{ adjacency[k].of( 0, pick[ from ] ) };
+          return std::binary_search( S.begin(), S.end(), pick[ into ] );
+        };
+
         constexpr int EXIT { 0 }; // :code index for exit
         constexpr int START{ 1 }; // :code index where main loop started
         constexpr int OUTER{ 2 }; // :code index where first node assigned
-        int o{ START }; // :index of the  current intruction in the `code` array
+
+        auto claim = [&]( unsigned l )->int{                                                                   // [+] 2026.10.19
+                                                                                                                              /*
+          Take next untried candidate of own frame; -1 if none:
+                                                                                                                              */
+          uint64_t r{ W.range[l].load( std::memory_order_relaxed ) };
+          for(;;){
+            if( ( r & M24 ) >= ( ( r >> 24 ) & M24 ) ) return -1;
+            if( W.range[l].compare_exchange_weak( r, r + 1, std::memory_order_acq_rel ) ) return int( r & M24 );
+          }
+        };
+
+        auto steal = [&]()->int{                                                                               // [+] 2026.10.19
+                                                                                                                              /*
+          Take upper half of untried candidates of the shallowest frame (the largest subtrees) of
+          other worker, with assignment of the levels above it; CAS succeeds only if the frame was
+          not touched since the assignment was read. Returns code index to continue or EXIT:
+                                                                                                                              */
+          for( unsigned k = 1; k < Nt; k++ ){
+            Worker& V{ worker[ ( t + k ) % Nt ] };
+            for( unsigned l = 0; l < Nl; l++ ){
+              uint64_t r{ V.range[l].load( std::memory_order_acquire ) };
+              for(;;){
+                const uint64_t next{ r & M24 }, end{ ( r >> 24 ) & M24 };
+                if( next >= end ) break;
+                uint32_t prefix[ CAPACITY ];
+                for( unsigned p = 0; p < l; p++ ) prefix[p] = V.pick[ code[ at[p] ].node ].load( std::memory_order_relaxed );
+                const uint64_t mid{ next + ( end - next )/2 };
+                if( not V.range[l].compare_exchange_strong( r, pack( r >> 48, mid, next ), std::memory_order_acq_rel ) ) continue;
+                det .reset();
+                open.reset();
+                for( unsigned p = 0; p < l; p++ ){
+                  const unsigned q{ code[ at[p] ].node };
+                  pick[q] = prefix[p];
+                  var [q] = node[q].candidates[ prefix[p] ];
+                  W.pick[q].store( prefix[p], std::memory_order_relaxed );
+                  W.range[p].store( pack( ( W.range[p].load( std::memory_order_relaxed ) >> 48 ) + 1, 0, 0 ), std::memory_order_release );
+                  det .set( q );
+                  open.set( p ); // :exhausted frame, so task ends when stolen range done
+                }
+                W.range[l].store( pack( ( W.range[l].load( std::memory_order_relaxed ) >> 48 ) + 1, end, mid ), std::memory_order_release );
+                open.set( l );
+                len[ code[ at[l] ].node ] = source( code[ at[l] ].node, l ); // :same list as owner has
+                if( out ){ fprintf( out, "\n STEAL level %u [%lu, %lu)", l, mid, end ); fflush( out ); }
+                return at[l];
+              }
+            }
+          }
+          return EXIT;
+        };
+
+        int o{ t == 0 ? START : EXIT }; // :index of the  current intruction in the `code` array             // [m] 2026.10.19
 
         for(;;){
 
+          if( o == EXIT ){                                                                                     // [+] 2026.10.19
+                                                                                                                              /*
+            Task done: steal other one; search finished when nobody runs task or tries to steal:
+                                                                                                                              */
+            busy--;
+            for(;;){
+              if( stop ) return;
+              busy++;
+              o = steal();
+              if( o != EXIT ) break;
+              busy--;
+              if( busy == 0 ) return;
+              std::this_thread::yield();
+            }
+          }
+
           assert( o >= 0 and o < vacant );
 
           Code& cmd{ code[o] };
@@ -1953,16 +3214,24 @@ namespace CoreAGI {
 
             case NODE:
               if( out ){ fprintf( out, "NODE %u", cmd.node ); fflush( out ); }
-              { bool complete{ false };
+              { const unsigned l{ level[ cmd.node ] };                                                         // [m] 2026.10.19
+                if( not open[l] ){ // :new frame
+                  open.set( l );
+                  len[ cmd.node ] = source( cmd.node, l );                                                     // [+] 2026.10.19
+                  W.range[l].store( pack( ( W.range[l].load( std::memory_order_relaxed ) >> 48 ) + 1, len[ cmd.node ], 0 ), std::memory_order_release );
+                }
+                bool complete{ false };
                 bool twin    { false };
                 do{
-                  if( cmd.node == Eo.from ) num[ cmd.node ] += Nt; else num[ cmd.node ]++;                     // [+] 2021.01.02
-                  if( num[ cmd.node ] >= len[ cmd.node ] ){
+                  num[ cmd.node ] = stop ? -1 : claim( l );                                                    // [m] 2026.10.19
+                  if( num[ cmd.node ] < 0 ){
                     complete = true;
                     if( out ){ fprintf( out, " complete" ); fflush( out ); }
                     break;
                   }
-                  var[ cmd.node ] = node[ cmd.node ].candidates[ num[ cmd.node ] ];
+                  pick[ cmd.node ] = list[l] ? list[l][ num[ cmd.node ] ] : num[ cmd.node ];                   // [+] 2026.10.19
+                  var [ cmd.node ] = node[ cmd.node ].candidates[ pick[ cmd.node ] ];                          // [m] 2026.10.19
+                  W.pick[ cmd.node ].store( pick[ cmd.node ], std::memory_order_relaxed );                     // [+] 2026.10.19
                   if( out ){ fprintf( out, " <= %s (%u/%u)", lex( var[ cmd.node ] ).c_str(),
                                                            num[ cmd.node ], len[ cmd.node] ); fflush( out ); }
                   twin = false;
@@ -1973,12 +3242,12 @@ namespace CoreAGI {
                   if( out ) if( twin ){ fprintf( out, " twin\n             " ); fflush( out ); }
                 } while( twin );
                 if( complete ){
+                  open.reset( l );
+                  det .reset( cmd.node );
                   if( o == OUTER ){
                     o = EXIT;
                     if( out ){ fprintf( out, "  EXIT" ); fflush( out ); }
                   } else {
-                    det.reset( cmd.node );
-                    num[ cmd.node ] = -1;
                     o = cmd.jump;
                     if( out ){ fprintf( out, "  JUMP to %u", o ); fflush( out ); }
                   }
@@ -1992,11 +3261,8 @@ namespace CoreAGI {
             case EDGE:
               if( out ){ fprintf( out, "EDGE %u:%s -> %u:%s", cmd.node, lex( var[ cmd.node ] ).c_str(),
                                                               cmd.into, lex( var[ cmd.into ] ).c_str() ); fflush( out ); }
-              totalTests++;
               {
-                Entity from = recover( var[ cmd.node ] );
-                Entity into = recover( var[ cmd.into ] );
-                if( from.is( into ) ){
+                if( adjacent( cmd.node, cmd.into ) ){                                                          // [m] 2026.10.19
                   if( out ){ fprintf( out, " fit" ); fflush( out ); }
                   o++;
                 } else {
@@ -2011,7 +3277,7 @@ namespace CoreAGI {
               {
                 Sequence Q = sequence();
                 for( unsigned i = 0; i < N; i++ ){
-                  Q += recover( var[i] );
+                  Q += view ? view->entity( var[i] ) : recover( var[i] );                                      // [m] 2026.10.19
                   if( out ) fprintf( out, " %s", lex( var[i] ).c_str() );
                 }
                 if( out ){ fprintf( out, " ]" ); fflush( out ); }
@@ -2019,7 +3285,8 @@ namespace CoreAGI {
                   o = cmd.jump;
                   if( out ){ fprintf( out, "  JUMP to %u", o ); fflush( out ); }
                 } else {
-                  o = EXIT;
+                  stop = true; // :other workers stop as well                                                  // [+] 2026.10.19
+                  o    = EXIT;
                   if( out ){ fprintf( out, "  EXIT" ); fflush( out ); }
                 }
               }
@@ -2034,32 +3301,33 @@ namespace CoreAGI {
       };//run
 
       if( Nt == 1 ){
-        run( 1, 0 );
+        run( 0 );                                                                                              // [m] 2026.10.19
       } else {
         std::vector< std::thread > T;
-        for( int t = 0; t < Nt; t++ ) T.push_back( std::thread( run, Nt, t ) );
+        for( unsigned t = 0; t < Nt; t++ ) T.push_back( std::thread( run, t ) );                               // [m] 2026.10.19
         for( auto& Ti: T ) Ti.join();
       }
+      if( out ) fclose( out );                                                                                 // [+] 2026.10.19
 
       return true;
 
-    }//analogic
+    }//analogic_
 
   };//class Gnosis
 
 
   const Gnosis::Syndrome Gnosis::Entity::S() const {
-    Gnosis&      G      { gnosis()        };
-    Shard&       segment{ G.segment( id ) };
-    const Signs* Y      { segment[id]     };
+    const Gnosis& G      { gnosis()        };                                                                  // [m] 2026.10.19
+    const Shard&  segment{ G.segment( id ) };                                                                  // [m] 2026.10.19
+    const Signs*  Y      { segment[id]     };
     Gnosis::Syndrome result { Y ? Gnosis::Syndrome{ unit, *Y } : Gnosis::Syndrome{ unit } };
      return result;
   }
 
   const Gnosis::Sequence Gnosis::Entity::Q() const {
-    Gnosis&    G      { gnosis()        };
-    Shard&     segment{ G.segment( id ) };
-    const Seq* Q      { segment.Q( id ) };
+    const Gnosis& G      { gnosis()        };                                                                  // [m] 2026.10.19
+    const Shard&  segment{ G.segment( id ) };                                                                  // [m] 2026.10.19
+    const Seq*    Q      { segment.Q( id ) };
     return Q ? Gnosis::Sequence{ unit, *Q } : Gnosis::Sequence{ unit };
   }
 
@@ -16,6 +16,7 @@ ________________________________________________________________________________
 #include <vector>
 #include <wchar.h>
 
+#include "batch.h"                                                                                             // [+] 2026.10.19
 #include "def.h"
 #include "hmi.h"
 #include "gnosis.h"
@@ -114,42 +115,50 @@ int main( int argc, char *argv[] ){
     auto WINDMILL    = glossary.entity( "windmill"                                                       );
     auto QUOTED      = glossary.entity( "quoted entity"                                                  );
 
-    auto SPACE_VEHICLE        = gnosis.entity( { SPACE,    VEHICLE     } );
-    auto GROUND_VEHICLE       = gnosis.entity( { GROUND,   VEHICLE     } );
-    auto USES_WIND            = gnosis.entity( { USES,     WIND        } );
-    auto USES_OXYGEN          = gnosis.entity( { USES,     OXYGEN      } );
-    auto USES_GASOLINE        = gnosis.entity( { USES,     GASOLINE    } );
-    auto USES_METHANE         = gnosis.entity( { USES,     METHANE     } );
-    auto PRODUCES_ELECTRICITY = gnosis.entity( { PRODUCES, ELECTRICITY } );
-    auto USES_ELECTRICITY     = gnosis.entity( { USES,     ELECTRICITY } );
+    auto CHEMICAL_FORMULA = glossary.entity( "chemical formula", { gnosis.ATTRIBUTE, gnosis.STRING   } );      // [m] 2026.10.19
+    auto MOLECULAR_MASS   = glossary.entity( "molecular mass",   { gnosis.ATTRIBUTE, gnosis.RATIONAL } );      // [m] 2026.10.19
+    data.columnar( Identity( MOLECULAR_MASS ), 'r' ); // :mass of all compounds aggregated by column scan          // [+] 2026.10.19
+    data.indexed ( Identity( MOLECULAR_MASS ), 'r' ); // :compounds selected by mass range                        // [+] 2026.10.19
+                                                                                                                              /*
+    Compound entities, connections, sequences and data are applied atomically as a single batch:
+                                                                                                                              */
+    Gnosis::Batch batch{ gnosis, &data };                                                                      // [+] 2026.10.19
+
+    auto SPACE_VEHICLE        = batch.entity( { SPACE,    VEHICLE     } );
+    auto GROUND_VEHICLE       = batch.entity( { GROUND,   VEHICLE     } );
+    auto USES_WIND            = batch.entity( { USES,     WIND        } );
+    auto USES_OXYGEN          = batch.entity( { USES,     OXYGEN      } );
+    auto USES_GASOLINE        = batch.entity( { USES,     GASOLINE    } );
+    auto USES_METHANE         = batch.entity( { USES,     METHANE     } );
+    auto PRODUCES_ELECTRICITY = batch.entity( { PRODUCES, ELECTRICITY } );
+    auto USES_ELECTRICITY     = batch.entity( { USES,     ELECTRICITY } );
                                                                                                                               /*
     Connectons:
                                                                                                                               */
-    STARSHIP   += USES_METHANE;
-    STARSHIP   += USES_OXYGEN;
-    STARSHIP   += SPACE_VEHICLE;
-    STARSHIP   += REUSABLE;
-    COMPUTER   += USES_ELECTRICITY;
-    MOTORCYCLE += USES_GASOLINE;
-    WINDMILL   += USES_WIND;
-    WINDMILL   += PRODUCES_ELECTRICITY;
+    batch.incl( STARSHIP,   USES_METHANE         );
+    batch.incl( STARSHIP,   USES_OXYGEN          );
+    batch.incl( STARSHIP,   SPACE_VEHICLE        );
+    batch.incl( STARSHIP,   REUSABLE             );
+    batch.incl( COMPUTER,   USES_ELECTRICITY     );
+    batch.incl( MOTORCYCLE, USES_GASOLINE        );
+    batch.incl( WINDMILL,   USES_WIND            );
+    batch.incl( WINDMILL,   PRODUCES_ELECTRICITY );
                                                                                                                               /*
     Attributes and sequence:
                                                                                                                               */
-    auto CHEMICAL_FORMULA = glossary.entity( "chemical formula", { gnosis.ATTRIBUTE, gnosis.STRING } );
-    METHANE += CHEMICAL_FORMULA;
+    batch.incl( METHANE, CHEMICAL_FORMULA );
+    batch.incl( METHANE, MOLECULAR_MASS   );
 
-    auto MOLECULAR_MASS = glossary.entity( "molecular mass", { gnosis.ATTRIBUTE, gnosis.RATIONAL } );
-    METHANE += MOLECULAR_MASS;
-
-    ELECTRICITY.seq( { COMPUTER, WINDMILL } );
+    batch.seq( ELECTRICITY, { COMPUTER, WINDMILL } );
 
     using Cargo = Data::Cargo;
 
-    METHANE.seq( { HYDROCARBON, STARSHIP } );
+    batch.seq( METHANE, { HYDROCARBON, STARSHIP } );
+
+    batch.put( METHANE, CHEMICAL_FORMULA, Cargo{ "CH4"   } );
+    batch.put( METHANE, MOLECULAR_MASS,   Cargo{ 16.043d } );
 
-    data.put( METHANE, CHEMICAL_FORMULA, Cargo{ "CH4"   } );
-    data.put( METHANE, MOLECULAR_MASS,   Cargo{ 16.043d } );
+    log.sure( batch.commit() == Gnosis::Batch::COMMITTED, kit( "Batch failure: %s", batch.error().c_str() ) ); // [+] 2026.10.19
 
   }
 
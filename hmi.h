@@ -11,6 +11,10 @@
  2021.06.05 Updated
  2021.06.14 Updated
 
+ 2026.10.19 Added `#W[folder]` command: incremental checkpoint written in background
+            (see `Gnosis.checkpointInBackground(..)`), so input processed while it written;
+            termination waits for the checkpoint in progress
+
 ________________________________________________________________________________________________________________________________
                                                                                                                               */
 #ifndef HMI_H_INCLUDED
@@ -216,6 +220,7 @@ namespace CoreAGI {
     std::vector< std::vector< Gnosis::Entity > >  DENY;      // :set of pair that defines what must be rejected in `analogy`
     std::vector< std::string >                    result;
     std::string                                   messageId; // :part of datagram
+    bool                                          storing;   // :checkpoint posted by `#W`                     // [+] 2026.10.19
                                                                                                                               /*
     Note: identical to one defined in the terminal.h
                                                                                                                               */
@@ -273,6 +278,7 @@ namespace CoreAGI {
       created .clear();
       DICT    .clear();
       SHOW    .clear();
+      glossary.dictChanged();                                                                                  // [+] 2026.10.19
       DENY    .clear();
       ORDV    .clear();
     }
@@ -290,7 +296,8 @@ namespace CoreAGI {
       created  {                              },
       DICT     {                              },
       result   {                              },
-      messageId{ 0                            }
+      messageId{ 0                            },
+      storing  { false                        }                                                                // [+] 2026.10.19
     {
       Timer timer;
       while( not channel.live() ){
@@ -630,8 +637,8 @@ namespace CoreAGI {
             if( type == gnosis.RATIONAL ){ data.put( key, Cargo{                 val->rational   } ); return; }
             if( type == gnosis.STRING   ){ data.put( key, Cargo{ std::to_string( val->rational ) } ); return; }
             break;
-          case '\0' :
-            if( type == gnosis.STRING   ){ data.put( key, Cargo{                 val->lex.data   } ); return; }
+          case '\0' : case 's' :                                                                                 // [m] 2026.10.19
+            if( type == gnosis.STRING   ){ data.put( key, Cargo{                 *val            } ); return; }
             if( type == gnosis.INTEGER  ){ result.push_back( "Can't convert string to integer"     ); return; }
             if( type == gnosis.RATIONAL ){ result.push_back( "Can't convert string to rational"    ); return; }
             break;
@@ -656,7 +663,14 @@ namespace CoreAGI {
         switch( val->type() ){
           case 'i' : result.push_back( kit( "%s%i%s",     YELLOW, val->integer,  RESET ) ); return;
           case 'r' : result.push_back( kit( "%s%f%s",     YELLOW, val->rational, RESET ) ); return;
-          case '\0': result.push_back( kit( "%s\"%s\"%s", YELLOW, val->lex.data, RESET ) ); return;
+          case '\0':
+          case 's' : result.push_back( kit( "%s\"%s\"%s", YELLOW, val->c_str(),  RESET ) ); return;                // [m] 2026.10.19
+          case 'p' :                                                                                           // [+] 2026.10.19
+            if( const Span* S{ data.span( data.key( obj, atr ) ) } ){
+              result.push_back( kit( "%s[%f, %f]%s", YELLOW, S->o, S->t, RESET ) );
+              return;
+            }
+            break;
           default  : break;
         }
         result.push_back( kit( "%s%s%s", xRED, Symbol::EMPTY_SET, RESET ) );
@@ -696,6 +710,7 @@ namespace CoreAGI {
             std::string name{ glossary.ref( e, "c", dict ) };
             variable[ name          ] = Identity( e );
             DICT    [ Identity( e ) ] = name;
+            glossary.dictChanged();                                                                            // [+] 2026.10.19
             //log.vital( kit( "uniq(): Anonymous variable `%s` created", name.c_str() ) ); log.flush(); // DEBUG
           } else {
             Encoded< Identity > encoded{ Identity( e ) };
@@ -776,7 +791,9 @@ namespace CoreAGI {
         std::set< std::vector< Identity > > table;    // :storage for results
         Config::gnosis::spurt = true;
         Timer timer;
+        const Gnosis::Snapshot view{ gnosis.snapshot() }; // :search over immutable image of the graph         // [+] 2026.10.19
         bool done = gnosis.analogic(
+          view,                                                                                                // [+] 2026.10.19
           pattern,
           mask,
           [&]( const Gnosis::Sequence& group )->bool {
@@ -784,7 +801,7 @@ namespace CoreAGI {
             bool accept{ true };
             for( unsigned i = 0; i < group.size(); i++ ){
               auto subj = group[i];
-              for( const auto& sign: DENY.at( i ) ) if( subj.is( sign ) ) accept = false;
+              for( const auto& sign: DENY.at( i ) ) if( view.is( subj, sign ) ) accept = false;                // [m] 2026.10.19
               if( SHOW[i] ) row.push_back( Identity( subj ) );
             }
             if( accept ) table.insert( row );
@@ -864,6 +881,7 @@ namespace CoreAGI {
           //std::string t{ CONV( parser.COL[i].data() ) };
           std::string name{ glossary.ref( e, "cv" ) };
           DICT.insert_or_assign( Identity( e ), name );
+          glossary.dictChanged();                                                                              // [+] 2026.10.19
           log.vital( kit( " %8s", name.c_str() ) );
         }
         log.flush();
@@ -1039,6 +1057,7 @@ namespace CoreAGI {
             if( not variable.contains( term.lex ) ){
               variable[ term.lex ] = term.id;
               DICT    [ term.id  ] = term.lex;
+              glossary.dictChanged();                                                                          // [+] 2026.10.19
             }
             break;
           case Term::IDNT:
@@ -1064,6 +1083,7 @@ namespace CoreAGI {
         created.push_back( e );
         variable[ name          ] = Identity( e );
         DICT    [ Identity( e ) ] = name;
+        glossary.dictChanged();                                                                                // [+] 2026.10.19
         Encoded< Identity > encoded{ Identity( e ) };
         log.vital( kit( "Created variable [[%s]] %s%s%s", encoded.c_str(), WHITE, name.c_str(), RESET ) );
       }
@@ -1259,6 +1279,7 @@ namespace CoreAGI {
         send( FACTS, kit( "%sGnosis   %6u%s", YELLOW, gnosis  .size(), RESET ) );
         send( FACTS, kit( "%sGlossary %6u%s", YELLOW, glossary.size(), RESET ) );
         send( FACTS, kit( "%sData     %6u%s", YELLOW, data    .size(), RESET ) );
+        if( gnosis.checkpointing() ) send( FACTS, kit( "%sCheckpoint in progress%s", YELLOW, RESET ) );        // [+] 2026.10.19
       };
 
       for(;;){
@@ -1278,6 +1299,29 @@ namespace CoreAGI {
               case 'D' : send( PRIOR, DOWN() ); break;
               case 'S' :              STAT();   break;
               case '@' : send( FACTS, VERS() ); break; // :language info
+              case '?' :                                                                                       // [+] 2026.10.19
+              {
+                                                                                                                              /*
+                Names that start with given prefix: `#?prefix`
+                                                                                                                              */
+                const std::string prefix{ source.substr( 2 ) };
+                const auto        found { glossary.complete( prefix ) };
+                if( found.empty() ) send( FACTS, kit( "%sno names start with `%s`%s", YELLOW, prefix.c_str(), RESET ) );
+                for( const auto& name: found ) send( FACTS, kit( "%s%s%s", YELLOW, name.c_str(), RESET ) );
+                break;
+              }
+              case 'W' :                                                                                       // [+] 2026.10.19
+              {
+                                                                                                                              /*
+                Checkpoint written in background: `#W` or `#Wfolder`
+                                                                                                                              */
+                const std::string folder{ source.length() > 2 ? source.substr( 2 ) : Config::hmi::STORAGE };
+                const bool        posted{ gnosis.checkpointInBackground( folder.c_str() ) };
+                storing = storing or posted;
+                send( FACTS, posted  ? kit( "%scheckpoint into `%s` started%s", YELLOW, folder.c_str(), RESET )
+                                     : kit( "%scheckpoint rejected%s",          xRED,                  RESET ) );
+                break;
+              }
               default  :                        break; // :just ignore
             }
             continue;
@@ -1285,6 +1329,10 @@ namespace CoreAGI {
                                                                                                                               /*
           Terminate:
                                                                                                                               */
+          if( storing ){                                                                                       // [+] 2026.10.19
+            log.vital( "Wait for checkpoint.." ); log.flush();
+            log.vital( gnosis.waitCheckpoint() ? "Checkpoint written" : "Checkpoint failed" );
+          }
           std::stringstream S;
           S << YELLOW << "Buy!" << RESET;
           send( QUIT, S.str() );
@@ -1344,6 +1392,18 @@ namespace CoreAGI {
           error << RED << "Statement contains unknown entities that expected to be known." << RESET;
           log.vital( error.str() );
           send( ERROR, error.str() );
+          for( const auto& name: expected ){                                                                   // [+] 2026.10.19
+                                                                                                                              /*
+            Suggest known names close to the unknown one:
+                                                                                                                              */
+            const auto close{ glossary.similar( name ) };
+            if( close.empty() ) continue;
+            std::string list;
+            for( const auto& lex: close ) list += ( list.empty() ? "" : ", " ) + lex;
+            const std::string hint{ kit( "%s%s%s: did you mean %s?", YELLOW, name.c_str(), RESET, list.c_str() ) };
+            log.vital( hint );
+            send( INFO, hint );
+          }
         } else if( authorized() ){
           log.vital( "Authorized" ); log.flush(); // DEBUG
                                                                                                                               /*
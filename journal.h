@@ -0,0 +1,355 @@
+                                                                                                                              /*
+ Copyright Mykola Rabchevskiy 2021.
+ Distributed under the Boost Software License, Version 1.0.
+ (See http://www.boost.org/LICENSE_1_0.txt)
+ ______________________________________________________________________________
+
+ Journal - binary append-only write-ahead log with group commit.
+
+ File layout:
+
+   header: 8 bytes magic `GelWAL01`, uint32 version, uint32 endianness mark
+   frames: uint32 size, uint32 CRC-32 of the payload, uint64 LSN, payload
+
+ Payload is opaque for the Journal. Committing thread appends frame into the
+ memory buffer and waits until the frame written (and synchronized to disk
+ if required); one of the waiting threads (leader) writes all accumulated
+ frames by single `write` and single `fdatasync` so concurrent commits share
+ the cost of the disk synchronization.
+
+ Torn (incomplete or corrupted) frame at the end of the file is ignored at
+ replay and cut off when journal opened for appending.
+
+ 2026.10.19 Initial version
+ 2026.10.19 `reset()` keeps LSN mark; `replay(..)` skips frames covered by checkpoint
+________________________________________________________________________________________________________________________________
+                                                                                                                              */
+#ifndef JOURNAL_H_INCLUDED
+#define JOURNAL_H_INCLUDED
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "config.h"
+#include "crc.h"
+
+namespace CoreAGI {
+
+  class Journal {
+  public:
+
+    enum Sync: uint8_t {
+      NEVER    = 0, // :data flushing left to OS
+      ALWAYS   = 1, // :commit returns after `fdatasync`
+      INTERVAL = 2  // :background `fdatasync` each `interval` millisec
+    };
+
+    static const char* lex( Sync sync ){
+      switch( sync ){
+        case NEVER   : return "NEVER";
+        case ALWAYS  : return "ALWAYS";
+        case INTERVAL: return "INTERVAL";
+        default      : break;
+      }
+      return nullptr;
+    }
+
+  private:
+
+    static constexpr char     MAGIC[ 8 ]{ 'G', 'e', 'l', 'W', 'A', 'L', '0', '1' };
+    static constexpr uint32_t VERSION   { 1          };
+    static constexpr uint32_t ENDIAN    { 0x01020304 }; // :written in native byte order
+    static constexpr size_t   HEADER    { sizeof( MAGIC ) + 2*sizeof( uint32_t ) };
+
+    struct Frame {
+      uint32_t size; // :payload size
+      uint32_t crc;  // :payload CRC-32
+      uint64_t lsn;  // :log sequence number
+    };
+
+    static_assert( sizeof( Frame ) == 16 );
+
+    int                       fd;          // :file descriptor
+    Sync                      policy;
+    unsigned                  interval;    // :millisec, for INTERVAL policy
+    std::string               ERROR;       // :last error description
+
+    std::mutex                mutex;
+    std::condition_variable   written;     // :notified when group of frames written
+    std::vector< uint8_t >    pending;     // :frames waiting to be written
+    uint64_t                  lastLsn;     // :last assigned LSN
+    uint64_t                  writtenLsn;  // :last LSN written into file
+    uint64_t                  durableLsn;  // :last LSN synchronized to disk
+    bool                      leader;      // :some thread writes pending frames now
+    std::atomic< bool >       failed;      // :write error happened (read by `live()` without lock)
+
+    std::thread               syncer;      // :background thread for INTERVAL policy
+    std::atomic< bool >       stop;
+
+    bool writeAll( const uint8_t* data, size_t size ){
+      while( size > 0 ){
+        const ssize_t n{ ::write( fd, data, size ) };
+        if( n < 0 ){
+          if( errno == EINTR ) continue;
+          ERROR = kit( "write: %s", strerror( errno ) );
+          return false;
+        }
+        data += n;
+        size -= size_t( n );
+      }
+      return true;
+    }
+
+    static void synchronizer( Journal* J ){
+                                                                                                                              /*
+      Thread function for INTERVAL policy:
+                                                                                                                              */
+      while( not J->stop.load() ){
+        std::this_thread::sleep_for( std::chrono::milliseconds( J->interval ) );
+        uint64_t lsn, durable;
+        { std::lock_guard< std::mutex > lock( J->mutex ); lsn = J->writtenLsn; durable = J->durableLsn; }
+        if( lsn == durable ) continue;
+        if( fdatasync( J->fd ) == 0 ){
+          std::lock_guard< std::mutex > lock( J->mutex );
+          J->durableLsn = lsn;
+        }
+      }
+    }
+
+    static bool scan(
+      const std::vector< uint8_t >&                                   file,
+      std::function< bool( uint64_t, std::span< const uint8_t > ) > f,
+      size_t&                                                         end,  // :end of the valid part
+      uint64_t&                                                       lsn,  // :last valid LSN
+      std::string&                                                    error
+    ){
+                                                                                                                              /*
+      Check header and call `f` for each valid frame; stop at torn frame:
+                                                                                                                              */
+      end = 0;
+      lsn = 0;
+      if( file.size() < HEADER                              ){ error = "too short file";  return false; }
+      if( memcmp( file.data(), MAGIC, sizeof( MAGIC ) ) != 0 ){ error = "not a journal";   return false; }
+      uint32_t version, endian;
+      memcpy( &version, file.data() + sizeof( MAGIC ),                    sizeof( uint32_t ) );
+      memcpy( &endian,  file.data() + sizeof( MAGIC ) + sizeof( uint32_t ), sizeof( uint32_t ) );
+      if( version != VERSION ){ error = kit( "unsupported version %u", version ); return false; }
+      if( endian  != ENDIAN  ){ error = "alien byte order";                      return false; }
+      size_t pos{ HEADER };
+      end = pos;
+      while( pos + sizeof( Frame ) <= file.size() ){
+        Frame F;
+        memcpy( &F, file.data() + pos, sizeof( Frame ) );
+        if( pos + sizeof( Frame ) + F.size > file.size() ) break; // :incomplete frame
+        const uint8_t* payload{ file.data() + pos + sizeof( Frame ) };
+        if( crc32( payload, F.size ) != F.crc ) break;             // :corrupted frame
+        if( F.lsn <= lsn                      ) break;             // :garbage
+        if( f and not f( F.lsn, std::span< const uint8_t >( payload, F.size ) ) ) break;
+        pos += sizeof( Frame ) + F.size;
+        end  = pos;
+        lsn  = F.lsn;
+      }
+      return true;
+    }
+
+    static bool read( const char* path, std::vector< uint8_t >& file, std::string& error ){
+      FILE* in = fopen( path, "rb" );
+      if( not in ){ error = kit( "can`t open `%s`", path ); return false; }
+      fseek( in, 0, SEEK_END );
+      const long size{ ftell( in ) };
+      fseek( in, 0, SEEK_SET );
+      file.resize( size_t( size ) );
+      const bool ok{ fread( file.data(), 1, file.size(), in ) == file.size() };
+      fclose( in );
+      if( not ok ) error = kit( "can`t read `%s`", path );
+      return ok;
+    }
+
+  public:
+
+    Journal():
+      fd        { -1    },
+      policy    { NEVER },
+      interval  { Config::journal::SYNC_INTERVAL },
+      ERROR     {       },
+      mutex     {       },
+      written   {       },
+      pending   {       },
+      lastLsn   { 0     },
+      writtenLsn{ 0     },
+      durableLsn{ 0     },
+      leader    { false },
+      failed    { false },
+      syncer    {       },
+      stop      { false }
+    {}
+
+    Journal( const Journal& ) = delete;
+    Journal& operator = ( const Journal& ) = delete;
+
+   ~Journal(){ close(); }
+
+    bool open( const char* path, Sync sync = ALWAYS, unsigned millisec = Config::journal::SYNC_INTERVAL ){
+                                                                                                                              /*
+      Open existing journal for appending (torn tail cut off) or create new one:
+                                                                                                                              */
+      close();
+      policy   = sync;
+      interval = millisec;
+      failed   = false;
+      size_t   end{ 0 };
+      uint64_t lsn{ 0 };
+      if( access( path, F_OK ) == 0 ){
+        std::vector< uint8_t > file;
+        if( not read( path, file, ERROR )              ) return false;
+        if( not scan( file, nullptr, end, lsn, ERROR ) ) return false;
+        fd = ::open( path, O_WRONLY );
+        if( fd < 0 ){ ERROR = kit( "can`t open `%s`: %s", path, strerror( errno ) ); return false; }
+        if( ftruncate( fd, off_t( end ) ) != 0 or lseek( fd, off_t( end ), SEEK_SET ) < 0 ){
+          ERROR = kit( "can`t truncate `%s`: %s", path, strerror( errno ) );
+          close();
+          return false;
+        }
+      } else {
+        fd = ::open( path, O_WRONLY | O_CREAT | O_TRUNC, 0644 );
+        if( fd < 0 ){ ERROR = kit( "can`t create `%s`: %s", path, strerror( errno ) ); return false; }
+        if( not reset() ){ close(); return false; }
+      }
+      lastLsn = writtenLsn = durableLsn = lsn;
+      if( policy == INTERVAL ){
+        stop.store( false );
+        syncer = std::thread( synchronizer, this );
+      }
+      return true;
+    }
+
+    void close(){
+      if( fd < 0 ) return;
+      flush();
+      stop.store( true );
+      if( syncer.joinable() ) syncer.join();
+      if( policy != NEVER ) fdatasync( fd );
+      ::close( fd );
+      fd = -1;
+    }
+
+    bool live() const { return fd >= 0 and not failed; }
+
+    const std::string& error() const { return ERROR; }
+
+    uint64_t lsn() const { return lastLsn; }
+
+    bool reset(){
+                                                                                                                              /*
+      Drop all frames, i.e. leave header only; used after checkpoint (full save). Empty frame
+      with the last LSN kept, so numbering continues after reopening and LSN fences of the
+      checkpoints (see `Gnosis.checkpointFence()`) remain comparable:
+                                                                                                                              */
+      std::lock_guard< std::mutex > lock( mutex );
+      if( fd < 0 ) return false;
+      pending.clear();
+      uint8_t header[ HEADER + sizeof( Frame ) ];
+      memcpy( header,                                         MAGIC,    sizeof( MAGIC    ) );
+      memcpy( header + sizeof( MAGIC ),                       &VERSION, sizeof( uint32_t ) );
+      memcpy( header + sizeof( MAGIC ) + sizeof( uint32_t ), &ENDIAN,   sizeof( uint32_t ) );
+      const Frame F{ 0, crc32( nullptr, 0 ), lastLsn };
+      memcpy( header + HEADER, &F, sizeof( Frame ) );
+      if( ftruncate( fd, 0 ) != 0 or lseek( fd, 0, SEEK_SET ) < 0 ){ ERROR = strerror( errno ); return false; }
+      if( not writeAll( header, lastLsn ? sizeof( header ) : HEADER ) ) return false;
+      if( policy != NEVER ) fdatasync( fd );
+      writtenLsn = durableLsn = lastLsn;
+      return true;
+    }
+
+    uint64_t append( std::span< const uint8_t > payload ){
+                                                                                                                              /*
+      Enqueue frame; returns its LSN (zero if journal is not opened):
+                                                                                                                              */
+      std::lock_guard< std::mutex > lock( mutex );
+      if( fd < 0 ) return 0;
+      const Frame F{ uint32_t( payload.size() ), crc32( payload.data(), payload.size() ), ++lastLsn };
+      const size_t pos{ pending.size() };
+      pending.resize( pos + sizeof( Frame ) + payload.size() );
+      memcpy( pending.data() + pos,                  &F,             sizeof( Frame ) );
+      memcpy( pending.data() + pos + sizeof( Frame ), payload.data(), payload.size()  );
+      return F.lsn;
+    }
+
+    bool sync( uint64_t lsn ){
+                                                                                                                              /*
+      Wait until frame `lsn` written (and synchronized for ALWAYS policy):
+                                                                                                                              */
+      std::unique_lock< std::mutex > lock( mutex );
+      auto done = [&](){ return ( policy == ALWAYS ? durableLsn : writtenLsn ) >= lsn; };
+      while( not done() ){
+        if( failed ) return false;
+        if( leader ){ written.wait( lock ); continue; }
+                                                                                                                              /*
+        This thread becomes leader and writes all pending frames as a group:
+                                                                                                                              */
+        leader = true;
+        std::vector< uint8_t > group;
+        group.swap( pending );
+        const uint64_t last{ lastLsn };
+        lock.unlock();
+        bool ok{ writeAll( group.data(), group.size() ) };
+        if( ok and policy == ALWAYS and fdatasync( fd ) != 0 ){ ERROR = kit( "fdatasync: %s", strerror( errno ) ); ok = false; }
+        lock.lock();
+        leader = false;
+        if( ok ){
+          writtenLsn = last;
+          if( policy == ALWAYS ) durableLsn = last;
+        } else {
+          failed = true;
+        }
+        written.notify_all();
+      }
+      return true;
+    }
+
+    bool commit( std::span< const uint8_t > payload ){ return sync( append( payload ) ); }
+
+    bool flush(){ return sync( lastLsn ); }
+
+    static size_t replay(
+      const char*                                                     path,
+      std::function< bool( uint64_t, std::span< const uint8_t > ) > f,
+      std::string*                                                    error = nullptr,
+      uint64_t                                                        after = 0
+    ){
+                                                                                                                              /*
+      Call `f` for each valid non-empty frame with LSN above `after`; returns number of processed frames:
+                                                                                                                              */
+      std::string            E;
+      std::vector< uint8_t > file;
+      size_t                 n  { 0 };
+      size_t                 end{ 0 };
+      uint64_t               lsn{ 0 };
+      auto counted = [&]( uint64_t lsn, std::span< const uint8_t > payload )->bool{
+        if( lsn <= after or payload.empty() ) return true; // :covered by checkpoint or LSN mark
+        if( not f( lsn, payload ) ) return false;
+        n++;
+        return true;
+      };
+      if( not read( path, file, E ) or not scan( file, counted, end, lsn, E ) ){ if( error ) *error = E; }
+      return n;
+    }
+
+  };//class Journal
+
+}//namespace CoreAGI
+
+#endif // JOURNAL_H_INCLUDED
@@ -0,0 +1,496 @@
+                                                                                                                              /*
+ Copyright Mykola Rabchevskiy 2021.
+ Distributed under the Boost Software License, Version 1.0.
+ (See http://www.boost.org/LICENSE_1_0.txt)
+ ______________________________________________________________________________
+
+  Names - bidirectional map entity ID <-> name with single copy of each name:
+
+    - names kept in append-only arena as records `length (4 bytes), chars, '\0'`,
+      so name referred by 32-bit offset and available as string_view or C-string;
+    - direct index: ID -> offset of the name;
+    - reverse index: open-addressing table of slots (hash, offset, ID) probed by
+      string_view, so name resolution needs no temporary string and no allocation.
+
+  Space of the forgotten names reclaimed by compaction when it exceeds space of live ones.
+
+  Prefix index: offsets of the names sorted by name, so names with given prefix form a
+  contiguous range found by binary search; new names merged in lazily, forgotten ones purged.
+
+  Trigram index (built on first approximate lookup): distinct trigrams of the name padded by two
+  '\0' at both ends -> names that contain it, sorted by offset. Name within edit distance k of
+  the pattern keeps all but at most 3k trigrams of the pattern, so it contains at least one of
+  any 3k+1 of them: candidates taken from the shortest 3k+1 lists, filtered by length and number
+  of common trigrams, then verified by Levenshtein distance.
+
+  2026.10.19 Initial version
+
+  2026.10.19 Prefix index and Names.complete(..) / Names.common(..)
+
+  2026.10.19 Trigram index and Names.similar(..)
+
+  2026.10.19 Names.image(..) / Names.adopt(..): table of names and blob of records laid out as
+             the arena, so image adopted as the arena without copying the names
+________________________________________________________________________________________________________________________________
+                                                                                                                              */
+#ifndef NAMES_H_INCLUDED
+#define NAMES_H_INCLUDED
+
+#include <cstdint>
+#include <cstring>
+
+#include <algorithm>
+#include <functional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "def.h"
+#include "flat_hash.h"
+
+namespace CoreAGI {
+
+  class Names {
+
+    static constexpr uint32_t EMPTY  { 0xFFFFFFFF        }; // :offset of vacant slot
+    static constexpr uint32_t TOMB   { 0xFFFFFFFE        }; // :offset of slot of the removed name
+    static constexpr size_t   HEADER { sizeof( uint32_t ) }; // :length prefix of the record
+    static constexpr size_t   SLACK  { 1 << 20           }; // :garbage bytes tolerated without compaction
+
+    struct Slot {
+      uint32_t hash;
+      uint32_t offset;
+      Identity id;
+    };
+
+    std::vector< char >                      arena;   // :records of the names
+    ska::flat_hash_map< Identity, uint32_t > offset;  // :ID -> offset of the name
+    std::vector< Slot >                      slot;    // :reverse index, size is power of 2
+    size_t                                   used;    // :slots occupied by names
+    size_t                                   tombs;   // :slots of removed names
+    size_t                                   garbage; // :bytes of the removed records
+    uint64_t                                 revision; // :counter of modifications
+
+    struct Entry {
+      uint32_t offset;
+      Identity id;
+    };
+
+    mutable std::vector< Entry > sorted; // :prefix index; may contain forgotten names
+    mutable std::vector< Entry > fresh;  // :names added after the last merge
+    mutable size_t               stale;  // :forgotten names in the index
+
+    mutable ska::flat_hash_map< uint32_t, std::vector< Entry > > gram;    // :trigram -> names that contain it
+    mutable bool                                                 grams;   // :trigram index built
+    mutable size_t                                               indexed; // :names in trigram index
+    mutable size_t                                               ghosts;  // :forgotten names in trigram index
+
+    static uint32_t hash( std::string_view name ){ return uint32_t( std::hash< std::string_view >{}( name ) ); }
+
+    std::string_view at( uint32_t off ) const {
+      uint32_t length;
+      memcpy( &length, arena.data() + off, HEADER );
+      return std::string_view( arena.data() + off + HEADER, length );
+    }
+
+    size_t probe( std::string_view name, uint32_t h ) const {
+                                                                                                                              /*
+      Slot of the name or vacant slot where the probe stopped:
+                                                                                                                              */
+      const size_t mask{ slot.size() - 1 };
+      for( size_t i = h & mask;; i = ( i + 1 ) & mask ){
+        const Slot& s{ slot[i] };
+        if( s.offset == EMPTY ) return i;
+        if( s.offset != TOMB and s.hash == h and at( s.offset ) == name ) return i;
+      }
+    }
+
+    void place( uint32_t h, uint32_t off, Identity id ){
+      const size_t mask{ slot.size() - 1 };
+      size_t i{ h & mask };
+      while( slot[i].offset != EMPTY and slot[i].offset != TOMB ) i = ( i + 1 ) & mask;
+      if( slot[i].offset == TOMB ) tombs--;
+      slot[i] = Slot{ h, off, id };
+      used++;
+    }
+
+    void rehash( size_t capacity ){
+      std::vector< Slot > old( capacity, Slot{ 0, EMPTY, CoreAGI::NIHIL } );
+      old.swap( slot );
+      used  = 0;
+      tombs = 0;
+      for( const Slot& s: old ) if( s.offset != EMPTY and s.offset != TOMB ) place( s.hash, s.offset, s.id );
+    }
+
+    uint32_t append( std::string_view name ){
+      const uint32_t off   { uint32_t( arena.size() ) };
+      const uint32_t length{ uint32_t( name.size()  ) };
+      arena.resize( arena.size() + HEADER + name.size() + 1 );
+      memcpy( arena.data() + off,          &length,     HEADER      );
+      memcpy( arena.data() + off + HEADER, name.data(), name.size() );
+      arena[ off + HEADER + name.size() ] = '\0';
+      return off;
+    }
+
+    bool live( const Entry& e ) const {
+      const auto it{ offset.find( e.id ) };
+      return it != offset.end() and it->second == e.offset;
+    }
+
+    void merge() const {
+                                                                                                                              /*
+      Bring prefix index up to date; forgotten names purged when they make a quarter of the index:
+                                                                                                                              */
+      auto less = [this]( const Entry& a, const Entry& b ){ return at( a.offset ) < at( b.offset ); };
+      if( 4*stale > sorted.size() ){
+        sorted.erase( std::remove_if( sorted.begin(), sorted.end(), [this]( const Entry& e ){ return not live( e ); } ), sorted.end() );
+        stale = 0;
+      }
+      if( fresh.empty() ) return;
+      std::sort( fresh.begin(), fresh.end(), less );
+      const size_t n{ sorted.size() };
+      sorted.insert( sorted.end(), fresh.begin(), fresh.end() );
+      std::inplace_merge( sorted.begin(), sorted.begin() + n, sorted.end(), less );
+      fresh.clear();
+    }
+
+    template< typename F > static void trigrams( std::string_view name, F f ){
+      uint32_t g{ 0 };
+      for( const char c: name ) f( g = ( g << 8 | uint8_t( c ) ) & 0xFFFFFF );
+      f( g = ( g << 8 ) & 0xFFFFFF );
+      f( g = ( g << 8 ) & 0xFFFFFF );
+    }
+
+    static std::vector< uint32_t > trigrams( std::string_view name ){
+      std::vector< uint32_t > G;
+      G.reserve( name.size() + 2 );
+      trigrams( name, [&]( uint32_t g ){ G.push_back( g ); } );
+      std::sort( G.begin(), G.end() );
+      G.erase( std::unique( G.begin(), G.end() ), G.end() );
+      return G;
+    }
+
+    void index( const Entry& e ) const {
+      for( const uint32_t g: trigrams( at( e.offset ) ) ) gram[ g ].push_back( e );
+      indexed++;
+    }
+
+    void grammar() const {
+                                                                                                                              /*
+      Build trigram index on demand; rebuilt when forgotten names make a quarter of it:
+                                                                                                                              */
+      if( grams and 4*ghosts <= indexed ) return;
+      gram.clear();
+      indexed = 0;
+      ghosts  = 0;
+      for( const auto& [ id, off ]: offset ) index( Entry{ off, id } );
+      for( auto& [ g, list ]: gram ) std::sort( list.begin(), list.end(), []( const Entry& a, const Entry& b ){ return a.offset < b.offset; } );
+      grams = true; // :names added later have greater offsets, lists stay sorted
+    }
+
+    static unsigned distance( std::string_view a, std::string_view b, unsigned k, std::vector< unsigned >& row ){
+                                                                                                                              /*
+      Levenshtein distance; `k + 1` as soon as it is known to exceed `k`:
+                                                                                                                              */
+      if( a.size() > b.size() ) std::swap( a, b );
+      if( b.size() - a.size() > k ) return k + 1;
+      row.resize( a.size() + 1 );
+      for( size_t i = 0; i <= a.size(); i++ ) row[i] = unsigned( i );
+      for( size_t j = 1; j <= b.size(); j++ ){
+        unsigned diag{ row[0] }, best{ row[0] = unsigned( j ) };
+        for( size_t i = 1; i <= a.size(); i++ ){
+          const unsigned up{ row[i] };
+          row[i] = std::min( { up + 1, row[ i - 1 ] + 1, diag + unsigned( a[ i - 1 ] != b[ j - 1 ] ) } );
+          diag   = up;
+          best   = std::min( best, row[i] );
+        }
+        if( best > k ) return k + 1;
+      }
+      return std::min( row[ a.size() ], k + 1 );
+    }
+
+    void compact(){
+                                                                                                                              /*
+      Copy live records into new arena and rebuild reverse index:
+                                                                                                                              */
+      std::vector< char > old;
+      old.swap( arena );
+      arena.reserve( old.size() - garbage );
+      for( auto& [ id, off ]: offset ){
+        uint32_t length;
+        memcpy( &length, old.data() + off, HEADER );
+        off = append( std::string_view( old.data() + off + HEADER, length ) );
+      }
+      garbage = 0;
+      std::fill( slot.begin(), slot.end(), Slot{ 0, EMPTY, CoreAGI::NIHIL } );
+      used  = 0;
+      tombs = 0;
+      for( const auto& [ id, off ]: offset ) place( hash( at( off ) ), off, id );
+      sorted.clear();
+      fresh .clear();
+      stale = 0;
+      for( const auto& [ id, off ]: offset ) fresh.push_back( Entry{ off, id } );
+      gram.clear();
+      grams = false;
+    }
+
+    void remove( size_t i ){
+      const uint32_t off{ slot[i].offset };
+      garbage += HEADER + at( off ).size() + 1;
+      offset.erase( slot[i].id );
+      revision++;
+      stale++;
+      if( grams ) ghosts++;
+      slot[i].offset = TOMB;
+      used--;
+      tombs++;
+    }
+
+  public:
+
+    struct Record { // :entry of the table of names of the image
+      Identity id;
+      uint32_t offset; // :offset of the record in the blob
+      uint32_t length; // :length of the name
+    };
+
+    Names(): arena{}, offset{}, slot( 16, Slot{ 0, EMPTY, CoreAGI::NIHIL } ), used{ 0 }, tombs{ 0 }, garbage{ 0 }, revision{ 0 },
+      sorted{}, fresh{}, stale{ 0 }, gram{}, grams{ false }, indexed{ 0 }, ghosts{ 0 }{}
+
+    size_t size () const { return offset.size(); }
+
+    uint64_t version() const { return revision; }
+    size_t bytes() const { return arena.size() + slot.size()*sizeof( Slot ) + offset.size()*( sizeof( Identity ) + sizeof( uint32_t ) ); }
+
+    Identity find( std::string_view name ) const {
+                                                                                                                              /*
+      ID of the entity with the name; NIHIL if none:
+                                                                                                                              */
+      const Slot& s{ slot[ probe( name, hash( name ) ) ] };
+      return s.offset == EMPTY ? CoreAGI::NIHIL : s.id;
+    }
+
+    std::string_view lex( Identity id ) const {
+                                                                                                                              /*
+      Name of the entity (zero-terminated); empty view if none:
+                                                                                                                              */
+      const auto it{ offset.find( id ) };
+      return it == offset.end() ? std::string_view{} : at( it->second );
+    }
+
+    bool contains( Identity id ) const { return offset.find( id ) != offset.end(); }
+
+    bool forget( Identity id ){
+      const std::string_view name{ lex( id ) };
+      if( name.empty() ) return false;
+      remove( probe( name, hash( name ) ) );
+      if( garbage > SLACK and garbage > arena.size() - garbage ) compact();
+      return true;
+    }
+
+    void let( Identity id, std::string_view name ){
+                                                                                                                              /*
+      Assign name to the entity; entity loses previous name, entity that had this name loses it:
+                                                                                                                              */
+      if( name.data() >= arena.data() and name.data() < arena.data() + arena.size() ){ // :view of own record
+        const std::string copy{ name };
+        let( id, copy );
+        return;
+      }
+      const std::string_view current{ lex( id ) };
+      if( current == name and not name.empty() ) return;
+      forget( id );
+      if( name.empty() ) return;
+      const uint32_t h{ hash( name ) };
+      if( const size_t i{ probe( name, h ) }; slot[i].offset != EMPTY ) remove( i );
+      if( 4*( used + tombs + 1 ) > 3*slot.size() ) rehash( 4*( used + 1 ) > slot.size() ? 2*slot.size() : slot.size() );
+      const uint32_t off{ append( name ) };
+      offset.insert_or_assign( id, off );
+      place( h, off, id );
+      fresh.push_back( Entry{ off, id } );
+      if( grams ) index( Entry{ off, id } );
+      revision++;
+    }
+
+    void clear(){
+      arena .clear();
+      offset.clear();
+      std::fill( slot.begin(), slot.end(), Slot{ 0, EMPTY, CoreAGI::NIHIL } );
+      used    = 0;
+      tombs   = 0;
+      garbage = 0;
+      revision++;
+      sorted.clear();
+      fresh .clear();
+      stale = 0;
+      gram.clear();
+      grams = false;
+    }
+
+    void reserve( size_t names, size_t bytes ){
+      arena .reserve( bytes + names*( HEADER + 1 ) );
+      offset.reserve( names );
+      size_t capacity{ slot.size() };
+      while( 3*capacity < 4*names ) capacity *= 2;
+      if( capacity > slot.size() ) rehash( capacity );
+    }
+
+    template< typename F > void each( F f ) const { for( const auto& [ id, off ]: offset ) f( id, at( off ) ); }
+
+    void image( std::vector< Record >& table, std::vector< char >& blob ) const {
+                                                                                                                              /*
+      Table of the names sorted by ID (same content gives same image) and blob of their records;
+      forgotten names dropped:
+                                                                                                                              */
+      std::vector< std::pair< Identity, uint32_t > > named( offset.begin(), offset.end() );
+      std::sort( named.begin(), named.end() );
+      table.clear();
+      blob .clear();
+      table.reserve( named.size() );
+      blob .reserve( arena.size() - garbage );
+      for( const auto& [ id, off ]: named ){
+        const size_t length{ at( off ).size() };
+        table.push_back( Record{ id, uint32_t( blob.size() ), uint32_t( length ) } );
+        blob.insert( blob.end(), arena.begin() + off, arena.begin() + off + HEADER + length + 1 );
+      }
+    }
+
+    bool adopt( std::vector< char >& blob, std::span< const Record > table ){
+                                                                                                                              /*
+      Replace content by the image made by `image(..)`; blob taken as the arena, indexes sized
+      once for all names; content not changed if the image is inconsistent (record out of the
+      blob, length mismatch, repeated ID or name):
+                                                                                                                              */
+      Names  N;
+      size_t total{ 0 }; // :bytes of the records
+      for( const Record& r: table ){
+        if( r.length == 0 or size_t( r.offset ) + HEADER + r.length + 1 > blob.size() ) return false;
+        uint32_t length;
+        memcpy( &length, blob.data() + r.offset, HEADER );
+        if( length != r.length or blob[ r.offset + HEADER + r.length ] != '\0' ) return false;
+        total += HEADER + r.length + 1;
+      }
+      if( total > blob.size() ) return false; // :overlapped records
+      N.arena.swap( blob );
+      N.reserve( table.size(), 0 );
+      N.fresh.reserve( table.size() );
+      for( const Record& r: table ){
+        const std::string_view name{ N.at( r.offset ) };
+        const uint32_t         h   { hash( name )     };
+        const size_t           i   { N.probe( name, h ) }; // :vacant slot unless name repeated
+        if( N.slot[i].offset != EMPTY or not N.offset.emplace( r.id, r.offset ).second ){
+          N.arena.swap( blob );
+          return false;
+        }
+        N.slot[i] = Slot{ h, r.offset, r.id };
+        N.used++;
+        N.fresh.push_back( Entry{ r.offset, r.id } );
+      }
+      N.garbage  = N.arena.size() - total;
+      N.revision = revision + 1;
+      *this = std::move( N );
+      return true;
+    }
+
+    template< typename F > size_t complete( std::string_view prefix, size_t limit, F f ) const {
+                                                                                                                              /*
+      Call `f( id, name )` for up to `limit` names that start with `prefix`, in alphabetical
+      order (so the name equal to `prefix` goes first); returns number of calls:
+                                                                                                                              */
+      merge();
+      size_t n{ 0 };
+      auto it{ std::lower_bound( sorted.begin(), sorted.end(), prefix,
+        [this]( const Entry& e, std::string_view p ){ return at( e.offset ) < p; } ) };
+      for( ; it != sorted.end() and n < limit; ++it ){
+        const std::string_view name{ at( it->offset ) };
+        if( not name.starts_with( prefix ) ) break;
+        if( not live( *it ) ) continue;
+        f( it->id, name );
+        n++;
+      }
+      return n;
+    }
+
+    std::string_view common( std::string_view prefix ) const {
+                                                                                                                              /*
+      Longest common prefix of all names that start with `prefix` (view of some name; empty if none):
+                                                                                                                              */
+      merge();
+      auto from{ std::lower_bound( sorted.begin(), sorted.end(), prefix,
+        [this]( const Entry& e, std::string_view p ){ return at( e.offset ) < p; } ) };
+      auto to  { std::upper_bound( from, sorted.end(), prefix,
+        [this]( std::string_view p, const Entry& e ){ return p < at( e.offset ).substr( 0, p.size() ); } ) };
+      while( from != to and not live( *from    ) ) ++from;
+      while( from != to and not live( *( to-1 ) ) ) --to;
+      if( from == to ) return {};
+      const std::string_view a{ at( from->offset ) }, b{ at( ( to - 1 )->offset ) };
+      const size_t L{ size_t( std::mismatch( a.begin(), a.end(), b.begin(), b.end() ).first - a.begin() ) };
+      return a.substr( 0, L );
+    }
+
+    template< typename F > size_t similar( std::string_view pattern, unsigned k, size_t limit, F f ) const {
+                                                                                                                              /*
+      Call `f( id, name, distance )` for up to `limit` names within edit distance `k` of the
+      `pattern`, nearest first (alphabetical order within the same distance); returns number of calls:
+                                                                                                                              */
+      grammar();
+      std::vector< std::pair< unsigned, Entry > > found;
+      std::vector< unsigned >                     row;
+      auto consider = [&]( const Entry& e ){
+        const unsigned d{ distance( pattern, at( e.offset ), k, row ) };
+        if( d <= k ) found.emplace_back( d, e );
+      };
+      const std::vector< uint32_t > G{ trigrams( pattern ) };
+      if( G.size() > 3*k ){
+        static const std::vector< Entry > NONE;
+        std::vector< const std::vector< Entry >* > list;
+        list.reserve( G.size() );
+        for( const uint32_t g: G ){
+          const auto it{ gram.find( g ) };
+          list.push_back( it == gram.end() ? &NONE : &it->second );
+        }
+        const size_t m{ 3*k + 1 };
+        std::partial_sort( list.begin(), list.begin() + m, list.end(), []( auto a, auto b ){ return a->size() < b->size(); } );
+        auto common = [&]( std::string_view name ){
+                                                                                                                              /*
+          Occurrences of the trigrams of the pattern in the name (not less than number of distinct ones):
+                                                                                                                              */
+          size_t n{ 0 };
+          trigrams( name, [&]( uint32_t g ){ n += std::binary_search( G.begin(), G.end(), g ); } );
+          return n;
+        };
+        std::vector< size_t > head( m, 0 );
+        for(;;){
+                                                                                                                              /*
+          Merge of the shortest lists (sorted by offset), each candidate visited once:
+                                                                                                                              */
+          uint32_t next{ EMPTY };
+          size_t   from{ m };
+          for( size_t i = 0; i < m; i++ ){
+            if( head[i] < list[i]->size() and ( *list[i] )[ head[i] ].offset < next ){ next = ( *list[i] )[ head[i] ].offset; from = i; }
+          }
+          if( from == m ) break;
+          const Entry e{ ( *list[ from ] )[ head[ from ] ] };
+          for( size_t i = 0; i < m; i++ ) if( head[i] < list[i]->size() and ( *list[i] )[ head[i] ].offset == next ) head[i]++;
+          const std::string_view name{ at( e.offset ) };
+          if( name.size() + k < pattern.size() or pattern.size() + k < name.size() ) continue;
+          if( common( name ) + 3*k < G.size() ) continue;
+          if( live( e ) ) consider( e );
+        }
+      } else {
+        for( const auto& [ id, off ]: offset ) consider( Entry{ off, id } ); // :too short pattern, no filter
+      }
+      std::sort( found.begin(), found.end(), [this]( const auto& a, const auto& b ){
+        return a.first < b.first or ( a.first == b.first and at( a.second.offset ) < at( b.second.offset ) );
+      });
+      if( found.size() > limit ) found.resize( limit );
+      for( const auto& [ d, e ]: found ) f( e.id, at( e.offset ), d );
+      return found.size();
+    }
+
+  };//class Names
+
+}//namespace CoreAGI
+
+#endif // NAMES_H_INCLUDED
@@ -27,16 +27,38 @@
 
   2020.12.29 Selection logic modified: empty syndrome mean all entities must be selected
 
+  2026.10.19 Sequences kept in copy-on-write buckets; added `Segment.freeze()`
+             that makes immutable image of the segment (see `Flat::MapView`);
+             bucket ownership tracked by generations started by `freeze()`
+
+             Added binary image of the segment: `Segment.image(..)` and `Segment.restore(..)`;
+             packed syndromes and sequences can be saved and restored separately;
+             added verbatim image: map pages written as is and adopted from memory
+             mapped file by `Segment.adopt(..)` (zero-copy restore)
+             Added `Segment.adopt( frozen )` that sets content of the frozen image
+             `Segment.image(..)` encodes frozen image of the segment, so it can be called
+             out of commit lock and concurrently for all segments
+             Textual images written from frozen segment via `EncodedWriter`
+             Added delta of verbatim image (`Segment.delta(..)`, `Segment.patch(..)`)
+             used by incremental checkpoints of the Gnosis
+             Index of the verbatim image keeps CRC-32 of each page; `Segment.check(..)` verifies
+             pages and keys of their entries before adoption
+
 ________________________________________________________________________________________________________________________________
                                                                                                                               */
+#include <algorithm>                                                                                           // [+] 2026.10.19
+#include <array>
 #include <atomic>
 #include <cassert>
+#include <memory>
 #include <random>
 #include <thread>
 #include <vector>
 #include <span>     // :require -std=c++-20 (so use gcc-10 or later)
 
+#include "codec.h"                                                                                             // [+] 2026.10.19
 #include "config.h"
+#include "crc.h"                                                                                               // [+] 2026.10.19
 #include "flat_hash.h"
 #include "flat.h"
 #include "seq.h"                                                                                               // [m] 2020.07.29
@@ -105,8 +127,21 @@ namespace CoreAGI {
           fatal error `cross-thread access`
                                                                                                                               */
     using E2Sequence = ska::flat_hash_map< Identity, Seq, IdentityHash >; // :map entity -> sequence
+                                                                                                                              /*
+    Sequences distributed over SEQUENCE_BUCKETS buckets that can be shared with
+    frozen images of the segment; shared bucket copied before modification:
+                                                                                                                              */
+    static constexpr unsigned SEQUENCE_BUCKETS{ 64 };                                                          // [+] 2026.10.19
 
-    E2Sequence  sequences;       // :map entity ID to entity name
+  public:
+
+    using Sequences = std::array< std::shared_ptr< E2Sequence >, SEQUENCE_BUCKETS >;                           // [+] 2026.10.19
+
+  private:
+
+    static unsigned bucket( const Identity id ){ return ( id/Config::gnosis::NUMBER_OF_SEGMENTS ) % SEQUENCE_BUCKETS; }
+
+    Sequences   sequences;       // :map entity ID to entity sequence                                          // [m] 2026.10.19
     std::thread thread;          // :permanently active thread
     unsigned    id;              // :index in the array of segmants
     char        NAME[ Config::logger::CHANNEL_NAME_CAPACITY ];
@@ -115,6 +150,9 @@ namespace CoreAGI {
     mutable std::atomic< bool     > live;
     mutable std::atomic< bool     > idle;
     mutable std::atomic< bool     > stop;
+    uint64_t                        revision;          // :counter of sequences modifications                  // [+] 2026.10.19
+    mutable std::atomic< uint64_t > epoch;             // :generation of the buckets (see `freeze()`)          // [+] 2026.10.19
+    uint64_t                        owner[ SEQUENCE_BUCKETS ]; // :generation of bucket creation               // [+] 2026.10.19
 
   public:
 
@@ -126,7 +164,10 @@ namespace CoreAGI {
       request  { nullptr             },
       live     { false               },
       idle     { true                },
-      stop     { false               }
+      stop     { false               },
+      revision { 0                   },
+      epoch    { 1                   },
+      owner    {                     }
     {}
 
     Segment( const Segment& ) = delete;
@@ -179,19 +220,47 @@ namespace CoreAGI {
                                                                                                                               /*
       Assign entity` sequence:
                                                                                                                               */
-      if( seq.size() > 0 ) sequences[id] = seq; else sequences.erase( id );
+      const unsigned                 b{ bucket( id )  };                                                       // [+] 2026.10.19
+      std::shared_ptr< E2Sequence >& B{ sequences[b] };                                                        // [m] 2026.10.19
+      if( not B ){
+        if( seq.size() == 0 ) return;
+        B        = std::make_shared< E2Sequence >();
+        owner[b] = epoch.load( std::memory_order_relaxed );
+      } else if( owner[b] != epoch.load( std::memory_order_acquire ) ){ // :shared with frozen image           // [m] 2026.10.19
+        B        = std::make_shared< E2Sequence >( *B );
+        owner[b] = epoch.load( std::memory_order_relaxed );
+      }
+      revision++;
+      if( seq.size() > 0 ) ( *B )[id] = seq; else B->erase( id );                                              // [m] 2026.10.19
+    }
+
+    static const Seq* Q( const Sequences& S, const Identity id ){                                              // [+] 2026.10.19
+      const auto& B{ S[ bucket( id ) ] };
+      if( not B ) return nullptr;
+      const auto& it = B->find( id );
+      if( it == B->end() ) return nullptr;
+      return &( it->second );
     }
 
-    const Seq* Q( const Identity id ) const {                                                                  // [m] 2020.07.29
+    const Seq* Q( const Identity id ) const { return Q( sequences, id ); }                                     // [m] 2026.10.19
                                                                                                                               /*
-      Get acces to entity` sequence:
+    Immutable image of the segment; it shares unchanged data with segment:
                                                                                                                               */
-      static const Seq NONE{};
-      const auto& it = sequences.find( id );
-      if( it == sequences.end() ) return nullptr;
-      return &( it->second );
+    struct Frozen {                                                                                            // [+] 2026.10.19
+      typename Map< Signs, CAPACITY >::View syndromes;
+      Sequences                             sequences;
+      uint64_t                              version;
+    };
+
+    Frozen freeze() const {                                                                                    // [+] 2026.10.19
+      epoch.fetch_add( 1, std::memory_order_acq_rel ); // :all buckets become shared (see `Flat::Map.freeze()`)
+      return Frozen{ Map< Signs, CAPACITY >::freeze(), sequences, version() };
     }
                                                                                                                               /*
+    Counter of modifications of syndromes and sequences:
+                                                                                                                              */
+    uint64_t version() const { return Map< Signs, CAPACITY >::version() + revision; }                          // [+] 2026.10.19
+                                                                                                                              /*
     Start search for requested data:
                                                                                                                               */
     bool select( Request& R, [[maybe_unused]]double timeout = 1000.0 /* millisec */ ) const {
@@ -223,7 +292,7 @@ namespace CoreAGI {
                                                                                                                               */
       std::vector< Identity > toBeProcessed;
       for( auto& entry: M ) if( entry.val.contains( sign ) ) toBeProcessed.push_back( entry.key );
-      for( const auto key: toBeProcessed ) M[key]->excl( sign );
+      for( const auto key: toBeProcessed ) M.mod( key )->excl( sign );                                         // [m] 2026.10.19
       return toBeProcessed.size();
     }
 
@@ -244,42 +313,405 @@ namespace CoreAGI {
 
     void clear(){
       Map< Signs, CAPACITY >::clear();
-      sequences.clear(); assert( sequences.size() == 0 );
+      for( auto& B: sequences ) B.reset();                                                                     // [m] 2026.10.19
+      revision++;
     }
 
-    unsigned saveSyndromes( FILE* out ) const {
+    static unsigned saveSyndromes( const Frozen& F, EncodedWriter& out ){                                      // [m] 2026.10.19
       unsigned n{ 0 };
-      for( const auto& entry: *this ){
-        Encoded< Identity > EncodedEntityId( entry.key );
-        fprintf( out, "%s", EncodedEntityId.c_str() );
-        Signs syndrome = entry.val;
-        for( const auto signId: syndrome ){
-          Encoded< Identity > EncodedSignId{ signId };
-          fprintf( out, " %s", EncodedSignId.c_str() );
-        }
-        fprintf( out, "\n" );
+      for( const auto& entry: F.syndromes ){
+        out.put( Identity( entry.key ) );
+        for( const auto signId: entry.val ){ out.put( ' ' ); out.put( signId ); }
+        out.put( '\n' );
         n++;
       }
       return n;
     }
 
-    unsigned saveSequences( FILE* out ) const {
-      auto write = [&]( const Identity& id )->bool{
-        Encoded< Identity > EncodedEntityId( id );
-        fprintf( out, " %s", EncodedEntityId.c_str() );
-        return true;
-      };
+    static unsigned saveSequences( const Frozen& F, EncodedWriter& out ){                                      // [m] 2026.10.19
       unsigned n{ 0 };
-      for( const auto& entry: sequences ){
-        Encoded< Identity > EncodedEntityId( entry.first );
-        fprintf( out, "%s", EncodedEntityId.c_str() );
-        entry.second.process( write );
-        fprintf( out, "\n" );
+      for( const auto& B: F.sequences ) if( B ) for( const auto& entry: *B ){                                  // [m] 2026.10.19
+        out.put( entry.first );
+        for( const auto e: entry.second ){ out.put( ' ' ); out.put( e ); }
+        out.put( '\n' );
         n++;
       }
       return n;
     }
 
+    static unsigned image( const Frozen& F, std::vector< uint8_t >& out, unsigned& Nq ){                       // [+] 2026.10.19
+                                                                                                                              /*
+      Append binary image of frozen segment `F` to `out`; returns number of syndromes,
+      number of sequences returned via `Nq`. Format (all numbers are varints):
+
+        number of cells of the map (`space`)
+        number of syndromes
+        for each entity ordered by home cell:  home cell delta, ID/space, number of signs, sign ID deltas
+        number of sequences
+        for each entity ordered by ID:         ID delta, length, elements ID (original order)
+
+      Home cell (ID % space) delta and quotient take one byte each in most cases; ordering
+      by home cell makes restoring write the map cells sequentially, that is a few times
+      faster than insertion in ID order:
+                                                                                                                              */
+      const unsigned Ns{ packSyndromes( F.syndromes, out ) };
+      Nq = packSequences( F.sequences, out );
+      return Ns;
+    }
+
+    bool restore( std::span< const uint8_t > data, unsigned& Ns, unsigned& Nq ){                               // [+] 2026.10.19
+                                                                                                                              /*
+      Replace content of the segment by decoded image (see `image(..)`); returns `false`
+      if image malformed or contains entity that does not belong to the segment:
+                                                                                                                              */
+      clear();
+      const uint8_t* p  { data.data()     };
+      const uint8_t* end{ p + data.size() };
+      return unpackSyndromes( p, end, Ns ) and unpackSequences( p, end, Nq ) and p == end;
+    }
+
+    static unsigned packSyndromes( const typename Map< Signs, CAPACITY >::View& M, std::vector< uint8_t >& out ){ // [+] 2026.10.19
+      struct Item {
+        Identity     key;
+        const Signs* signs;
+      };
+      const uint32_t      space{ Map< Signs, CAPACITY >::space() };
+      std::vector< Item > items;
+      items.reserve( M.size() );
+      for( const auto& entry: M ) items.push_back( Item{ entry.key, &entry.val } );
+      std::sort( items.begin(), items.end(), [space]( const Item& a, const Item& b )->bool{
+        return a.key % space != b.key % space ? a.key % space < b.key % space : a.key < b.key;
+      });
+      putVarint( out, space );
+      putVarint( out, uint32_t( items.size() ) );
+      uint32_t prev{ 0 };
+      std::vector< Identity > signs;
+      for( const auto& item: items ){
+        signs.clear();
+        for( const auto sign: *item.signs ) signs.push_back( sign );
+        std::sort( signs.begin(), signs.end() );
+        putVarint( out, item.key % space - prev );
+        putVarint( out, item.key / space        );
+        putVarint( out, uint32_t( signs.size() ) );
+        Identity prevSign{ 0 };
+        for( const auto sign: signs ){ putVarint( out, sign - prevSign ); prevSign = sign; }
+        prev = item.key % space;
+      }
+      return unsigned( items.size() );
+    }
+
+    static unsigned packSequences( const Sequences& S, std::vector< uint8_t >& out ){                          // [+] 2026.10.19
+      std::vector< Identity > keys;
+      for( const auto& B: S ) if( B ) for( const auto& entry: *B ) keys.push_back( entry.first );
+      std::sort( keys.begin(), keys.end() );
+      putVarint( out, uint32_t( keys.size() ) );
+      Identity prev{ 0 };
+      for( const auto key: keys ){
+        const Seq* q{ Q( S, key ) };
+        putVarint( out, key - prev );
+        putVarint( out, uint32_t( q->size() ) );
+        for( const auto e: *q ) putVarint( out, e );
+        prev = key;
+      }
+      return unsigned( keys.size() );
+    }
+
+  public:
+                                                                                                                              /*
+    Verbatim image of the segment: the map pages written as is, so restored segment uses
+    pages of the file mapped into memory instead of rebuilding the map. Layout:
+
+      Verbatim header
+      index of the present pages: number and CRC-32 of the page (uint32 each), ascending
+      packed sequences (see `image(..)`)
+      zero padding up to the `data` offset (multiple of ALIGNMENT)
+      present pages, sizeof( Entry )*pageCapacity() bytes each
+
+    Offsets are relative to the section begin that has to be aligned by ALIGNMENT in the file:
+                                                                                                                              */
+    static constexpr uint64_t ALIGNMENT{ 4096 }; // :memory page size                                          // [+] 2026.10.19
+
+    struct Verbatim {                                                                                          // [+] 2026.10.19
+      uint32_t space;     // :number of cells of the map
+      uint32_t entry;     // :sizeof( Entry )
+      uint32_t capacity;  // :entries per page
+      uint32_t cardinal;  // :number of syndromes
+      uint32_t pages;     // :number of present pages
+      uint32_t head;      // :bytes before padding (checksummed part)
+      uint64_t data;      // :offset of the first page
+    };
+
+    static_assert( sizeof( Verbatim ) == 32 );
+
+    static constexpr uint64_t INDEX{ 2*sizeof( uint32_t ) }; // :bytes of the index entry: page and its CRC-32 // [+] 2026.10.19
+
+  private:
+
+    static void verbatim( const Frozen& F, std::vector< uint8_t >& out, unsigned& Nq ){                        // [+] 2026.10.19
+                                                                                                                              /*
+      Append header, index and sequences of the verbatim image of frozen segment `F` to `out`
+      (pages itself written by caller from `F.syndromes`); `out` must be empty:
+                                                                                                                              */
+      using View = typename Map< Signs, CAPACITY >::View;
+      assert( out.empty() );
+      Verbatim H{};
+      H.space    = Map< Signs, CAPACITY >::space();
+      H.entry    = sizeof( typename View::Entry );
+      H.capacity = View::pageCapacity();
+      H.cardinal = F.syndromes.size();
+      out.resize( sizeof( H ) );
+      for( unsigned p = 0; p < View::pageCount(); p++ ) if( F.syndromes.pageData( p ) ){
+        const uint32_t entry[ 2 ]{ p, crc32( F.syndromes.pageData( p ), sizeof( typename View::Entry )*View::pageCapacity() ) }; // [m] 2026.10.19
+        const uint8_t* b{ reinterpret_cast< const uint8_t* >( entry ) };                                       // [m] 2026.10.19
+        out.insert( out.end(), b, b + INDEX );                                                                 // [m] 2026.10.19
+        H.pages++;
+      }
+      Nq = packSequences( F.sequences, out );
+      H.head = uint32_t( out.size() );
+      H.data = ( out.size() + ALIGNMENT - 1 )/ALIGNMENT*ALIGNMENT;
+      memcpy( out.data(), &H, sizeof( H ) );
+    }
+
+    bool adopt( std::span< uint8_t > data, const std::shared_ptr< uint8_t >& owner, unsigned& Nq ){            // [+] 2026.10.19
+                                                                                                                              /*
+      Replace content of the segment by verbatim image (see `verbatim(..)`) placed in memory
+      owned by `owner`; pages refer that memory and copied before first modification, so the
+      memory has to be private (see MAP_PRIVATE). Returns `false` if image malformed; pages and
+      keys of their entries have to be checked before (see `check(..)`):
+                                                                                                                              */
+      using View = typename Map< Signs, CAPACITY >::View;
+      using Page = typename View::Page;
+      using Entry = typename View::Entry;
+      clear();
+      if( data.size() < sizeof( Verbatim ) ) return false;
+      Verbatim H;
+      memcpy( &H, data.data(), sizeof( H ) );
+      constexpr uint64_t PAGE_SIZE{ sizeof( Entry )*View::pageCapacity() };
+      if( H.space    != Map< Signs, CAPACITY >::space()                                 ) return false;
+      if( H.entry    != sizeof( Entry ) or H.capacity != View::pageCapacity()           ) return false;
+      if( H.cardinal  > CAPACITY or H.pages > View::pageCount()                         ) return false;
+      if( H.head      > H.data or H.data % ALIGNMENT                                    ) return false;
+      if( H.data      > data.size() or data.size() - H.data != H.pages*PAGE_SIZE        ) return false;
+      if( sizeof( H ) + H.pages*INDEX > H.head                                          ) return false;        // [m] 2026.10.19
+      if( reinterpret_cast< uintptr_t >( data.data() ) % alignof( Entry )               ) return false;
+      std::vector< Page > pages( View::pageCount() );
+      const uint8_t* p{ data.data() + sizeof( H ) };
+      for( uint32_t i = 0; i < H.pages; i++, p += INDEX ){                                                     // [m] 2026.10.19
+        uint32_t k;
+        memcpy( &k, p, sizeof( k ) );
+        if( k >= View::pageCount() or pages[k] ) return false;
+        Entry* page{ reinterpret_cast< Entry* >( data.data() + H.data + i*PAGE_SIZE ) };
+        pages[k] = Page( owner, page ); // :aliasing constructor, shares ownership of the whole image
+      }
+      if( not unpackSequences( p, data.data() + H.head, Nq ) or p != data.data() + H.head ) return false;
+      Map< Signs, CAPACITY >::adopt( pages, H.cardinal );
+      return true;
+    }
+                                                                                                                              /*
+    Delta of the verbatim image: pages and sequence buckets of the segment changed since
+    frozen image `B` was taken. Page or bucket is changed if it is not shared with `B`, because
+    shared ones are copied before modification. Layout is the same as verbatim image except:
+
+      index contains changed pages; page that became absent marked by ABSENT bit and has no data
+      (its CRC-32 is zero)
+      number of changed buckets followed by bucket number and packed sequences of each bucket
+                                                                                                                              */
+    static constexpr uint32_t ABSENT{ 0x80000000 };                                                            // [+] 2026.10.19
+
+    static void delta( const Frozen& F, const Frozen& B, std::vector< uint8_t >& out,                          // [+] 2026.10.19
+                       std::vector< unsigned >& changed, unsigned& Nq ){
+                                                                                                                              /*
+      Append head of the delta to `out` (must be empty); numbers of changed present pages,
+      that caller writes after the head, returned via `changed`:
+                                                                                                                              */
+      using View = typename Map< Signs, CAPACITY >::View;
+      assert( out.empty() );
+      Verbatim H{};
+      H.space    = Map< Signs, CAPACITY >::space();
+      H.entry    = sizeof( typename View::Entry );
+      H.capacity = View::pageCapacity();
+      H.cardinal = F.syndromes.size();
+      out.resize( sizeof( H ) );
+      changed.clear();
+      for( unsigned p = 0; p < View::pageCount(); p++ ){
+        const auto* page{ F.syndromes.pageData( p ) };
+        if( page == B.syndromes.pageData( p ) ) continue;
+        const uint32_t entry[ 2 ]{ page ? p : p | ABSENT, page ? crc32( page, sizeof( *page )*View::pageCapacity() ) : 0 }; // [m] 2026.10.19
+        const uint8_t* b{ reinterpret_cast< const uint8_t* >( entry ) };                                       // [m] 2026.10.19
+        out.insert( out.end(), b, b + INDEX );                                                                 // [m] 2026.10.19
+        if( page ) changed.push_back( p );
+        H.pages++;
+      }
+      std::vector< unsigned > buckets;
+      for( unsigned b = 0; b < SEQUENCE_BUCKETS; b++ ) if( F.sequences[b] != B.sequences[b] ) buckets.push_back( b );
+      putVarint( out, uint32_t( buckets.size() ) );
+      Nq = 0;
+      for( const auto b: buckets ){
+        Sequences S{};
+        S[b] = F.sequences[b];
+        putVarint( out, b );
+        Nq += packSequences( S, out );
+      }
+      H.head = uint32_t( out.size() );
+      H.data = ( out.size() + ALIGNMENT - 1 )/ALIGNMENT*ALIGNMENT;
+      memcpy( out.data(), &H, sizeof( H ) );
+    }
+
+    bool patch( std::span< uint8_t > data, const std::shared_ptr< uint8_t >& owner, unsigned& Nq ){            // [+] 2026.10.19
+                                                                                                                              /*
+      Apply delta (see `delta(..)`) placed in memory owned by `owner` (see `adopt(..)`);
+      returns `false` if delta malformed:
+                                                                                                                              */
+      using View  = typename Map< Signs, CAPACITY >::View;
+      using Page  = typename View::Page;
+      using Entry = typename View::Entry;
+      if( data.size() < sizeof( Verbatim ) ) return false;
+      Verbatim H;
+      memcpy( &H, data.data(), sizeof( H ) );
+      constexpr uint64_t PAGE_SIZE{ sizeof( Entry )*View::pageCapacity() };
+      if( H.space    != Map< Signs, CAPACITY >::space()                                 ) return false;
+      if( H.entry    != sizeof( Entry ) or H.capacity != View::pageCapacity()           ) return false;
+      if( H.cardinal  > CAPACITY or H.pages > View::pageCount()                         ) return false;
+      if( H.head      > H.data or H.data % ALIGNMENT or H.data > data.size()            ) return false;
+      if( sizeof( H ) + H.pages*INDEX > H.head                                          ) return false;        // [m] 2026.10.19
+      if( reinterpret_cast< uintptr_t >( data.data() ) % alignof( Entry )               ) return false;
+      std::vector< unsigned > index;
+      std::vector< Page     > pages;
+      std::vector< bool     > seen( View::pageCount() );
+      uint64_t       offset{ H.data                  }; // :of the next present page
+      const uint8_t* p     { data.data() + sizeof( H ) };
+      for( uint32_t i = 0; i < H.pages; i++, p += INDEX ){                                                     // [m] 2026.10.19
+        uint32_t k;
+        memcpy( &k, p, sizeof( k ) );
+        const unsigned n{ k & ~ABSENT };
+        if( n >= View::pageCount() or seen[n] ) return false;
+        seen[n] = true;
+        index.push_back( n );
+        if( k & ABSENT ){ pages.push_back( Page{} ); continue; }
+        if( offset + PAGE_SIZE > data.size() ) return false;
+        pages.push_back( Page( owner, reinterpret_cast< Entry* >( data.data() + offset ) ) );
+        offset += PAGE_SIZE;
+      }
+      if( offset != data.size() ) return false;
+      const uint8_t* end{ data.data() + H.head };
+      uint32_t       n  { 0 };
+      if( not getVarint( p, end, n ) or n > SEQUENCE_BUCKETS ) return false;
+      Nq = 0;
+      std::vector< bool > touched( SEQUENCE_BUCKETS );
+      for( uint32_t i = 0; i < n; i++ ){
+        uint32_t b;
+        unsigned m{ 0 };
+        if( not getVarint( p, end, b ) or b >= SEQUENCE_BUCKETS or touched[b] ) return false;
+        touched[b] = true;
+        sequences[b].reset();
+        revision++;
+        if( not unpackSequences( p, end, m ) ) return false;
+        Nq += m;
+      }
+      if( p != end ) return false;
+      Map< Signs, CAPACITY >::adopt( index, pages, H.cardinal );
+      return true;
+    }
+
+    bool check( std::span< const uint8_t > data, bool delta ) const {                                          // [+] 2026.10.19
+                                                                                                                              /*
+      Check pages of the verbatim image or delta (see `verbatim(..)`, `delta(..)`) placed in memory
+      against CRC-32 kept in the index (the head itself is checked by caller) and keys of their
+      entries against the segment, so adopted pages never contain damaged or alien entries;
+      touches all pages, so it is done in parallel for segments before any of them adopted:
+                                                                                                                              */
+      using View  = typename Map< Signs, CAPACITY >::View;
+      using Entry = typename View::Entry;
+      constexpr uint64_t PAGE_SIZE{ sizeof( Entry )*View::pageCapacity() };
+      if( data.size() < sizeof( Verbatim ) ) return false;
+      Verbatim H;
+      memcpy( &H, data.data(), sizeof( H ) );
+      if( H.entry != sizeof( Entry ) or H.capacity != View::pageCapacity()              ) return false;
+      if( H.head  > H.data or H.data > data.size() or sizeof( H ) + H.pages*INDEX > H.head ) return false;
+      if( reinterpret_cast< uintptr_t >( data.data() + H.data ) % alignof( Entry )      ) return false;
+      uint64_t       offset{ H.data                  }; // :of the next present page
+      uint32_t       live  { 0                       }; // :entries of the present pages
+      const uint8_t* p     { data.data() + sizeof( H ) };
+      for( uint32_t i = 0; i < H.pages; i++, p += INDEX ){
+        uint32_t k, crc;
+        memcpy( &k,   p,                sizeof( k   ) );
+        memcpy( &crc, p + sizeof( k ),  sizeof( crc ) );
+        if( delta and ( k & ABSENT ) ) continue;
+        if( offset + PAGE_SIZE > data.size() ) return false;
+        const uint8_t* page{ data.data() + offset };
+        offset += PAGE_SIZE;
+        if( crc32( page, PAGE_SIZE ) != crc ) return false;
+        const Entry* E{ reinterpret_cast< const Entry* >( page ) };
+        for( unsigned e = 0; e < View::pageCapacity(); e++ ){
+          if( E[e].key == Flat::NIHIL or E[e].del ) continue;
+          if( not own( Identity( E[e].key ) ) ) return false;
+          live++;
+        }
+      }
+      return delta or live == H.cardinal; // :cardinality of the delta depends on the pages not changed
+    }
+
+    bool own( Identity key ) const {                                                                           // [+] 2026.10.19
+      return key != Flat::NIHIL and key < UINT24 and key % Config::gnosis::NUMBER_OF_SEGMENTS == id;
+    }
+
+    bool unpackSyndromes( const uint8_t*& p, const uint8_t* end, unsigned& Ns ){                               // [+] 2026.10.19
+      uint32_t space{ 0 };
+      uint32_t home { 0 };
+      uint32_t d    { 0 };
+      if( not getVarint( p, end, space ) or space == 0 or not getVarint( p, end, d ) ) return false;
+      Ns = d;
+      Signs syndrome{};
+      for( uint32_t i = 0; i < Ns; i++ ){
+        uint32_t q, m;
+        if( not getVarint( p, end, d ) or not getVarint( p, end, q ) or not getVarint( p, end, m ) ) return false;
+        home += d;
+        const uint64_t key{ uint64_t( q )*space + home };
+        if( home >= space or key >= UINT24 or not own( Identity( key ) ) ) return false;
+        syndrome.clear();
+        Identity sign{ 0 };
+        for( uint32_t j = 0; j < m; j++ ){
+          if( not getVarint( p, end, d ) or d >= UINT24 - sign ) return false; // :sign stays below UINT24     // [m] 2026.10.19
+          sign += d;
+          if( sign == Flat::NIHIL or not syndrome.incl( sign ) ) return false;                                 // [m] 2026.10.19
+        }
+        if( not Map< Signs, CAPACITY >::incl( Identity( key ), syndrome ) ) return false;
+      }
+      return true;
+    }
+
+    bool unpackSequences( const uint8_t*& p, const uint8_t* end, unsigned& Nq ){                               // [+] 2026.10.19
+      uint32_t d{ 0 };
+      if( not getVarint( p, end, d ) ) return false;
+      Nq = d;
+      Identity key{ 0 };
+      Seq seq_{};
+      for( uint32_t i = 0; i < Nq; i++ ){
+        uint32_t m;
+        if( not getVarint( p, end, d ) or not getVarint( p, end, m ) or d >= UINT24 - key ) return false;      // [m] 2026.10.19
+        key += d;
+        if( not own( key ) ) return false;
+        seq_.clear();
+        for( uint32_t j = 0; j < m; j++ ){
+          uint32_t e;
+          if( not getVarint( p, end, e ) or e == Flat::NIHIL or e >= UINT24 ) return false;                    // [m] 2026.10.19
+          seq_.append( e );
+        }
+        seq( key, seq_ );
+      }
+      return true;
+    }
+
+    void adopt( const Frozen& F ){                                                                             // [+] 2026.10.19
+                                                                                                                              /*
+      Replace content of the segment by frozen image (see `freeze()`) sharing pages and buckets with it:
+                                                                                                                              */
+      Map< Signs, CAPACITY >::adopt( F.syndromes );
+      sequences = F.sequences;
+      for( auto& o: owner ) o = 0; // :copied when written
+      revision++;
+    }
+
     static void service( const Segment* segment ){
                                                                                                                               /*
       The main thread function.
@@ -8,6 +8,7 @@
 
  2021.05.17 Modified
  2021.06.15 Modified
+ 2026.10.19 Hint of the `#W[folder]` command (checkpoint)
 ________________________________________________________________________________________________________________________________
                                                                                                                               */
 #ifndef TERMINAL_H_INCLUDED
@@ -364,7 +365,7 @@ namespace CoreAGI {
                                                                                                                               /*
                 Make decision about next state:
                                                                                                                               */
-                if( N == 2 and input[0].val == '#' ){ // There is not a Gel statement, continue editing:
+                if( N >= 2 and input[0].val == '#' ){ // There is not a Gel statement, continue editing:       // [m] 2026.10.19
                   clear();
                   return EDIT;
                 } else { // There is a Gel statement, switch to waiting AGI response:
@@ -533,6 +534,7 @@ namespace CoreAGI {
       printf( "\n\n %sTo finish terminal close window or type %sCtrl^C%s", YELLOW, RED,           RESET );
       printf(   "\n %sTo get AGI statistics: %s#S < ENTER >%s",            YELLOW, GREEN,         RESET );
       printf(   "\n %sTo get Gel version:    %s#@ < ENTER >%s",            YELLOW, GREEN,         RESET );
+      printf(   "\n %sTo write checkpoint:   %s#W[folder] < ENTER >%s",    YELLOW, GREEN,         RESET );     // [+] 2026.10.19
       printf(   "\n %sTo stop AGI:           %s#  < ENTER >%s",            YELLOW, GREEN,         RESET );
       printf(   "\n %sTo navigate over previous statements: %sUP DOWN%s",  YELLOW, GREEN,         RESET );
       printf(   "\n %sTo navigate over previous statements: %sUP DOWN%s",  YELLOW, GREEN,         RESET );
@@ -0,0 +1,879 @@
+                                                                                                                              /*
+ Copyright Mykola Rabchevskiy 2021.
+ Distributed under the Boost Software License, Version 1.0.
+ (See http://www.boost.org/LICENSE_1_0.txt)
+ ______________________________________________________________________________
+
+  Round-trip tests of the storage: each test builds small state, passes it through
+  the tested path (snapshot, image, journal, ..) and compares result with origin.
+  Exit code is number of failed checks.
+
+  2026.10.19 Initial version
+________________________________________________________________________________________________________________________________
+                                                                                                                              */
+#include <cstdio>
+#include <cstdlib>
+
+#include <algorithm>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "batch.h"
+#include "data.mini.h"
+#include "def.h"
+#include "glossary.h"
+#include "gnosis.h"
+#include "journal.h"
+#include "logger.h"
+#include "names.h"
+
+using namespace CoreAGI;
+
+namespace {
+
+  unsigned failed{ 0 };
+  unsigned passed{ 0 };
+
+  void check( bool ok, const char* what ){
+    if( ok ) passed++; else { failed++; printf( "\n FAILED: %s", what ); }
+  }
+
+                                                                                                                              /*
+  Empty folder for files of the test:
+                                                                                                                              */
+  std::filesystem::path folder( const char* name ){
+    const auto path{ std::filesystem::temp_directory_path()/"coreagi-test"/name };
+    std::filesystem::remove_all( path );
+    std::filesystem::create_directories( path );
+    return path;
+  }
+
+  void snapshot( Logger& logger ){
+                                                                                                                              /*
+    Snapshot keeps state of the moment; reads of the graph do not change its version:
+                                                                                                                              */
+    Gnosis G{ "Snapshot", logger };
+    auto A{ G.entity() }, B{ G.entity() }, X{ G.entity() };
+    X.incl( A );
+    const auto S{ G.snapshot() };
+    X.incl( B );
+    check(     S.is( X, A ),                "snapshot keeps sign included before it" );
+    check( not S.is( X, B ),                "snapshot does not see sign included after it" );
+    check( X.is( A ) and X.is( B ),         "graph sees both signs" );
+    const uint64_t v{ G.version() };
+    const bool     a{ X.is( A ) };
+    check( a and G.version() == v,          "lookup does not change version" );
+    X.excl( A );
+    check( S.is( X, A ) and not X.is( A ),  "exclusion after snapshot not seen by it" );
+    check( G.version() > v,                 "modification changes version" );
+  }
+
+  void batch( Logger& logger ){
+                                                                                                                              /*
+    Batch that can`t be applied completely is rejected before any change:
+                                                                                                                              */
+    Gnosis G{ "Batch", logger };
+    {
+      Gnosis::Batch B{ G };
+      auto X{ B.entity() };
+      B.incl( X, G.IMMORTAL ).forget( X );
+      check( B.commit() == B.REJECTED,       "batch forgetting immortal entity rejected" );
+      check( not G.exists( Identity( X ) ),  "rejected batch creates nothing" );
+    }
+    {
+      Gnosis::Batch B{ G };
+      auto X{ B.entity() };
+      for( unsigned i = 0; i <= Config::gnosis::CAPACITY_OF_SYNDROME; i++ ) B.incl( X, B.entity() );
+      check( B.commit() == B.REJECTED,       "batch overflowing syndrome rejected" );
+      check( not G.exists( Identity( X ) ),  "batch overflowing syndrome creates nothing" );
+    }
+    {
+      Gnosis::Batch B{ G };
+      auto X{ B.entity() }, Y{ B.entity() };
+      B.incl( X, Y );
+      check( B.commit() == B.COMMITTED,      "valid batch committed" );
+      check( G.recover( Identity( X ) ).is( G.recover( Identity( Y ) ) ), "valid batch applied" );
+    }
+    {
+      Journal J; // :not opened
+      Gnosis::Batch B{ G, nullptr, &J };
+      auto X{ B.entity() };
+      check( B.commit() == B.REJECTED,       "batch without live journal rejected" );
+      check( not G.exists( Identity( X ) ),  "batch without live journal creates nothing" );
+    }
+  }
+
+  void journal( Logger& logger ){
+                                                                                                                              /*
+    Batches committed with journal replayed over empty graph give the same graph and data:
+                                                                                                                              */
+    const std::string path{ ( folder( "journal" )/"journal" ).string() };
+    const std::string S15( 15, 'a' ), S16( 16, 'b' ), S40( 40, 'c' );
+    Identity x{ 0 }, y{ 0 }, t[3]{};
+    {
+      Gnosis     G{ "Journal", logger };
+      Data::Mini D{ "Data", logger, G };
+      Journal    J;
+      check( J.open( path.c_str() ), "journal opened" );
+      Gnosis::Batch B{ G, &D, &J };
+      auto X{ B.entity() }, Y{ B.entity() };
+      B.incl( X, Y ).put( X, Y, Data::Cargo( int64_t( -42 ) ) ).put( Y, X, Data::Cargo( 2.5 ) );
+      auto T0{ B.entity() }, T1{ B.entity() }, T2{ B.entity() };
+      B.put( X, T0, Data::Cargo( S15 ) ).put( X, T1, Data::Cargo( S16 ) ).put( X, T2, Data::Cargo( S40 ) );
+      check( B.commit() == B.COMMITTED, "batch journaled" );
+      t[0] = Identity( T0 );
+      t[1] = Identity( T1 );
+      t[2] = Identity( T2 );
+      B.excl( X, Y ).drop( Y, X );
+      check( B.commit() == B.COMMITTED, "second batch journaled" );
+      x = Identity( X );
+      y = Identity( Y );
+    }
+    Gnosis      G{ "Replay", logger };
+    Data::Mini  D{ "Data", logger, G };
+    std::string error;
+    check( Gnosis::Batch::replay( path.c_str(), G, &D, &error ) == 2, "journal replayed" );
+    check( G.exists( x ) and G.exists( y ),                             "created entities replayed" );
+    check( G.exists( x ) and not G.recover( x ).is( G.recover( y ) ),   "excluded sign replayed" );
+    Data::Cargo* v{ D.get( D.key( x, y ) ) };
+    check( v and v->type() == 'i' and v->integer == -42,                "integer value replayed" );
+    check( not D.contains( D.key( y, x ) ),                             "dropped value replayed" );
+    auto text = [&]( Identity atr, const std::string& s ){
+      const Data::Cargo* c{ D.get( D.key( x, atr ) ) };
+      return c and c->string() and c->view() == s;
+    };
+    check( text( t[0], S15 ), "string of 15 chars replayed" );
+    check( text( t[1], S16 ), "string of 16 chars replayed" );
+    check( text( t[2], S40 ), "string of 40 chars replayed" );
+  }
+
+  void image( Logger& logger ){
+                                                                                                                              /*
+    Image and checkpoint chain loaded into other graph give the same graph; rejected image
+    or chain does not change loaded graph:
+                                                                                                                              */
+    namespace fs = std::filesystem;
+    const fs::path dir{ folder( "image" ) };
+    using Pairs = std::vector< std::pair< Identity, Identity > >;
+    auto same = [&]( const Gnosis& H, const Pairs& P, size_t size ){
+      if( H.size() != size ) return false;
+      for( const auto& [ x, s ]: P ) if( not H.exists( x ) or not H.recover( x ).is( H.recover( s ) ) ) return false;
+      return true;
+    };
+    auto truncate = []( const fs::path& path ){ fs::resize_file( path, fs::file_size( path )/2 ); };
+    Gnosis G{ "Image", logger };
+    Pairs  P;
+    std::vector< Identity > E;
+    for( unsigned i = 0; i < 1000; i++ ){
+      auto X{ G.entity() };
+      for( unsigned k = 1; k <= 3 and k <= E.size(); k++ ){
+        const Identity s{ E[ ( i*7 + k*13 ) % E.size() ] };
+        X.incl( G.recover( s ) );
+        P.push_back( { Identity( X ), s } );
+      }
+      E.push_back( Identity( X ) );
+    }
+    const size_t N{ G.size() };
+    check( G.save( ( dir/"packed"   ).string().c_str(), Gnosis::PACKED   ), "packed image saved"   );
+    check( G.save( ( dir/"verbatim" ).string().c_str(), Gnosis::VERBATIM ), "verbatim image saved" );
+    check( G.checkpoint( ( dir/"chain" ).string().c_str() ),                "base checkpoint written" );
+    Pairs Q{ P };
+    for( unsigned i = 0; i < 100; i++ ){
+      const Identity x{ E[i] }, s{ E[ 999 - i ] };
+      G.recover( x ).incl( G.recover( s ) );
+      Q.push_back( { x, s } );
+    }
+    check( G.checkpoint( ( dir/"chain" ).string().c_str() ),                "delta checkpoint written" );
+    {
+      Gnosis H{ "Packed", logger };
+      check( H.load( ( dir/"packed" ).string().c_str() ) and same( H, P, N ),   "packed image round-trip" );
+    }
+    {
+      Gnosis H{ "Verbatim", logger };
+      check( H.load( ( dir/"verbatim" ).string().c_str() ) and same( H, P, N ), "verbatim image round-trip" );
+      H.recover( E[0] ).incl( H.recover( E[1] ) ); // :loaded pages copied before modification
+      Gnosis K{ "Verbatim", logger };
+      check( K.load( ( dir/"verbatim" ).string().c_str() ) and same( K, P, N ), "verbatim image not changed by graph" );
+    }
+    {
+      Gnosis H{ "Chain", logger };
+      check( H.load( ( dir/"chain" ).string().c_str() ) and same( H, Q, N ),    "checkpoint chain round-trip" );
+    }
+    fs::path delta;
+    for( const auto& f: fs::directory_iterator( dir/"chain" ) ) if( f.path().extension() == ".1" ) delta = f.path();
+    check( not delta.empty(), "delta checkpoint found" );
+    fs::create_directories( dir/"flipped" );
+    fs::copy_file( dir/"verbatim"/Config::gnosis::IMAGE, dir/"flipped"/Config::gnosis::IMAGE );
+    {
+      FILE* f{ fopen( ( dir/"flipped"/Config::gnosis::IMAGE ).string().c_str(), "r+b" ) };
+      const long at{ long( fs::file_size( dir/"flipped"/Config::gnosis::IMAGE ) ) - 100 }; // :in the last page
+      int  c{ EOF };
+      bool flipped{ f and fseek( f, at, SEEK_SET ) == 0 and ( c = fgetc( f ) ) != EOF };
+      flipped = flipped and fseek( f, at, SEEK_SET ) == 0 and fputc( c ^ 0x01, f ) != EOF;
+      if( f ) fclose( f );
+      check( flipped, "page of verbatim image damaged" );
+    }
+    fs::create_directories( dir/"alien" );
+    fs::copy_file( dir/"packed"/Config::gnosis::IMAGE, dir/"alien"/Config::gnosis::IMAGE );
+    {
+      FILE* f{ fopen( ( dir/"alien"/Config::gnosis::IMAGE ).string().c_str(), "r+b" ) };
+      const uint32_t capacity{ Config::gnosis::CAPACITY_OF_SEGMENT + 1 };
+      const bool     written{ f and fseek( f, 20, SEEK_SET ) == 0 and fwrite( &capacity, sizeof( capacity ), 1, f ) == 1 };
+      if( f ) fclose( f );
+      check( written, "capacity in image header changed" );
+    }
+    if( not delta.empty() ) truncate( delta );
+    truncate( dir/"verbatim"/Config::gnosis::IMAGE );
+    {
+      Gnosis H{ "Damaged", logger };
+      check( H.load( ( dir/"packed" ).string().c_str() ),                       "packed image loaded again" );
+      Pairs R{ P };
+      H.recover( E[5] ).incl( H.recover( E[900] ) ); // :differs from any image
+      R.push_back( { E[5], E[900] } );
+      check( not H.load( ( dir/"verbatim" ).string().c_str() ) and same( H, R, N ), "damaged image keeps graph" );
+      check( not H.load( ( dir/"chain"    ).string().c_str() ) and same( H, R, N ), "damaged delta keeps graph" );
+      check( not H.load( ( dir/"flipped"  ).string().c_str() ) and same( H, R, N ), "damaged page rejected" );
+      check( not H.load( ( dir/"alien"    ).string().c_str() ) and same( H, R, N ), "image of other capacity rejected" );
+                                                                                                                              /*
+      Full image older than damaged chain loaded instead of it:
+                                                                                                                              */
+      const fs::path older{ dir/"chain"/Config::gnosis::IMAGE };
+      fs::copy_file( dir/"packed"/Config::gnosis::IMAGE, older );
+      fs::last_write_time( older, fs::last_write_time( dir/"chain"/Config::gnosis::CHECKPOINT ) - std::chrono::hours( 1 ) );
+      check( H.load( ( dir/"chain" ).string().c_str() ) and same( H, P, N ),    "full image loaded when chain rejected" );
+    }
+  }
+
+  void data( Logger& logger ){
+                                                                                                                              /*
+    Data image written and loaded with the graph image and checkpoint; strings of `LAST`
+    chars are the longest kept in place, longer ones interned:
+                                                                                                                              */
+    namespace fs = std::filesystem;
+    const fs::path dir{ folder( "data" ) };
+    const std::string S15( 15, 'a' ), S16( 16, 'b' ), S40( 40, 'c' );
+    Gnosis     G{ "Data", logger };
+    Data::Mini D{ "Data", logger, G };
+    const Identity O{ Identity( G.entity() ) };
+    std::vector< Identity > A;
+    for( unsigned i = 0; i < 6; i++ ) A.push_back( Identity( G.entity() ) );
+    D.put( D.key( O, A[0] ), Data::Cargo( int64_t( -7 ) ) );
+    D.put( D.key( O, A[1] ), Data::Cargo( 0.125 ) );
+    D.put( D.key( O, A[2] ), Data::Cargo( S15 ) );
+    D.put( D.key( O, A[3] ), Data::Cargo( S16 ) );
+    D.put( D.key( O, A[4] ), Data::Cargo( S40 ) );
+    D.put( D.key( O, A[5] ), Span( 1.0, 2.0 ) );
+    check( D.get( D.key( O, A[2] ) )->type() == '\0', "15 chars kept in place" );
+    check( D.get( D.key( O, A[3] ) )->type() == 's',  "16 chars interned" );
+    auto same = [&]( const Data::Mini& M ){
+      auto text = [&]( unsigned i, const std::string& s ){
+        const Data::Cargo* v{ M.get( M.key( O, A[i] ) ) };
+        return v and v->string() and v->view() == s;
+      };
+      const Data::Cargo* i{ M.get( M.key( O, A[0] ) ) };
+      const Data::Cargo* r{ M.get( M.key( O, A[1] ) ) };
+      const Span*        p{ M.span( M.key( O, A[5] ) ) };
+      return M.size() == 6 and i and i->type() == 'i' and i->integer == -7 and r and r->type() == 'r' and r->rational == 0.125
+         and text( 2, S15 ) and text( 3, S16 ) and text( 4, S40 ) and p and p->o == 1.0 and p->t == 2.0;
+    };
+    check( G.save      ( ( dir/"saved" ).string().c_str() ), "graph and data saved" );
+    check( G.checkpoint( ( dir/"chain" ).string().c_str() ), "graph and data checkpointed" );
+    const fs::path image{ dir/"chain"/( std::string( "checkpoint.1.0." ) + Config::data::IMAGE ) };
+    check( fs::exists( dir/"saved"/Config::data::IMAGE ) and fs::exists( image ), "data images written" );
+    {
+      Gnosis     H{ "Saved", logger };
+      Data::Mini M{ "Data", logger, H };
+      check( H.load( ( dir/"saved" ).string().c_str() ) and same( M ), "data loaded with graph image" );
+    }
+    {
+      Gnosis     H{ "Chain", logger };
+      Data::Mini M{ "Data", logger, H };
+      check( H.load( ( dir/"chain" ).string().c_str() ) and same( M ), "data loaded with checkpoint" );
+                                                                                                                              /*
+      Header claims more records than the file has; rejected before allocation:
+                                                                                                                              */
+      const fs::path damaged{ dir/"damaged.img" };
+      fs::copy_file( image, damaged );
+      FILE* f{ fopen( damaged.string().c_str(), "r+b" ) };
+      const uint64_t huge{ uint64_t( 1 ) << 60 };
+      const bool     written{ f and fseek( f, 24, SEEK_SET ) == 0 and fwrite( &huge, sizeof( huge ), 1, f ) == 1 };
+      if( f ) fclose( f );
+      check( written,                                                 "header damaged" );
+      check( not M.load( damaged.string().c_str() ) and same( M ),    "damaged header rejected, data kept" );
+      fs::resize_file( image, fs::file_size( image ) - 1 );
+      check( not M.load( image.string().c_str() ) and same( M ),      "truncated image rejected, data kept" );
+    }
+    fs::resize_file( dir/"saved"/Config::data::IMAGE, fs::file_size( dir/"saved"/Config::data::IMAGE ) - 1 );
+    {
+      Gnosis       H{ "Saved", logger };
+      Data::Mini   M{ "Data", logger, H };
+      const size_t n{ H.size() };
+      check( not H.load( ( dir/"saved" ).string().c_str() ) and H.size() == n and M.empty(), "graph kept when data image rejected" );
+    }
+  }
+
+  void scans( Logger& logger ){
+                                                                                                                              /*
+    Range scans over Morton-ordered keys (attributes of object, objects of attribute) and change
+    of ID give the same results as brute force over reference map; keys include edge IDs, values
+    erased and put again:
+                                                                                                                              */
+    using Pair = std::pair< Identity, Identity >; // :object, attribute
+    Gnosis     G{ "Scans", logger };
+    Data::Mini D{ "Data", logger, G };
+    std::mt19937_64 random{ 3 };
+    std::vector< Identity > ids{ 1, 2, Flat::UINT24 - 2, Flat::UINT24 - 1, 0x555555, 0xAAAAAA };
+    while( ids.size() < 40 ) ids.push_back( Identity( 1 + random() % ( Flat::UINT24 - 1 ) ) );
+    std::map< Pair, int64_t > R;
+    auto pick = [&]{ return ids[ random() % ids.size() ]; };
+    auto same = [&]{
+      bool ok{ D.size() == R.size() };
+      for( const auto id: ids ){
+        std::set< std::pair< Identity, int64_t > > A, O, a, o;
+        D.attributes( id, [&]( const Identity& atr, const Data::Cargo& v ){ A.insert( { atr, v.integer } ); } );
+        D.objects   ( id, [&]( const Identity& obj, const Data::Cargo& v ){ O.insert( { obj, v.integer } ); } );
+        for( const auto& [ k, v ]: R ){
+          if( k.first  == id ) a.insert( { k.second, v } );
+          if( k.second == id ) o.insert( { k.first,  v } );
+        }
+        ok = ok and A == a and O == o;
+      }
+      return ok;
+    };
+    bool ok{ true };
+    for( unsigned n = 1; n <= 20000; n++ ){
+      const Identity x{ pick() }, y{ pick() };
+      const unsigned op{ unsigned( random() % 100 ) };
+      if( op < 60 ){
+        const int64_t v{ int64_t( random() % 1000 ) };
+        D.put( D.key( x, y ), Data::Cargo( v ) );
+        R[ { x, y } ] = v;
+      } else if( op < 95 ){
+        D.excl( D.key( x, y ) );
+        R.erase( { x, y } );
+      } else { // :change ID of the object or attribute `x` to `y` or forget it
+        const bool     attribute{ op % 2 == 0 };
+        const Identity to{ op < 98 ? y : CoreAGI::NIHIL };
+        std::vector< std::pair< Pair, int64_t > > moved;
+        for( auto it = R.begin(); it != R.end(); ){
+          if( ( attribute ? it->first.second : it->first.first ) != x ){ ++it; continue; }
+          moved.push_back( *it );
+          it = R.erase( it );
+        }
+        if( to != CoreAGI::NIHIL ){
+          for( auto& [ k, v ]: moved ) ( attribute ? k.second : k.first ) = to;
+          for( const auto& [ k, v ]: moved ) R[ k ] = v;
+        }
+        ok = D.change( x, to, attribute ) == moved.size() and ok;
+      }
+      if( n % 1000 == 0 ) ok = same() and ok;
+    }
+    check( ok, "range scans and change of ID match brute force" );
+  }
+
+  void morton( Logger& ){
+                                                                                                                              /*
+    Key combination by magic masks and by BMI2 (when CPU supports it), scalar and batch versions,
+    gives the same keys as the original 32-step loop; keys decombined back into the same IDs:
+                                                                                                                              */
+    auto reference = []( Identity obj, Identity atr ){
+      CoreAGI::Key key{ 0 };
+      for( unsigned i = 0; i < 32; i++ ){
+        if( obj & ( Identity( 1 ) << i ) ) key |= CoreAGI::Key( 1 ) << ( 2*i     );
+        if( atr & ( Identity( 1 ) << i ) ) key |= CoreAGI::Key( 1 ) << ( 2*i + 1 );
+      }
+      return key;
+    };
+    std::vector< Identity > ids{
+      0, 1, 2, Flat::UINT24 - 1, Flat::UINT24, 0x555555, 0xAAAAAA, 0x55555555, 0xAAAAAAAA, 0xFFFFFFFF
+    };
+    std::mt19937_64 random{ 4 };
+    for( unsigned i = 0; i < 1000; i++ ) ids.push_back( Identity( random() ) );
+    std::vector< Identity > O, A;
+    for( const auto obj: ids ) for( const auto atr: ids ){
+      if( O.size() >= 20000 ) break;
+      O.push_back( obj );
+      A.push_back( atr );
+    }
+    bool masks{ true }, bmi2{ true }, scalar{ true };
+    for( size_t i = 0; i < O.size(); i++ ){
+      const CoreAGI::Key key{ reference( O[i], A[i] ) };
+      masks = masks and ( Morton::spread( O[i] ) | ( Morton::spread( A[i] ) << 1 ) ) == key
+                    and Morton::squeeze( key ) == O[i] and Morton::squeeze( key >> 1 ) == A[i];
+      if( Morton::BMI2 ){
+        bmi2 = bmi2 and Morton::deposit( O[i], A[i] ) == key
+                    and Morton::extract( key, Morton::EVEN ) == O[i] and Morton::extract( key, Morton::ODD ) == A[i];
+      }
+      const auto [ obj, atr ]{ decombine( combination( O[i], A[i] ) ) };
+      scalar = scalar and combination( O[i], A[i] ) == key and obj == O[i] and atr == A[i]
+                      and objectOf( key ) == O[i] and attributeOf( key ) == A[i];
+    }
+    std::vector< CoreAGI::Key > K( O.size() );
+    std::vector< Identity >     O2( O.size() ), A2( O.size() );
+    combination( O, A, K );
+    decombine( K, O2, A2 );
+    bool batch{ O2 == O and A2 == A };
+    for( size_t i = 0; i < O.size(); i++ ) batch = batch and K[i] == reference( O[i], A[i] );
+    check( masks,  "magic masks match bit loop" );
+    check( bmi2,   "BMI2 matches bit loop (skipped without BMI2)" );
+    check( scalar, "combination and decombine round-trip" );
+    check( batch,  "batch combination and decombine match scalar ones" );
+  }
+
+  void compaction( Logger& logger ){
+                                                                                                                              /*
+    Chain of checkpoints compacted into new base after `CHECKPOINT_DELTAS` deltas; files of the
+    previous generation removed, restored graph is the last checkpointed one:
+                                                                                                                              */
+    namespace fs = std::filesystem;
+    const fs::path dir{ folder( "compaction" ) };
+    Gnosis G{ "Compaction", logger };
+    std::vector< Identity > E;
+    for( unsigned i = 0; i < 1000; i++ ) E.push_back( Identity( G.entity() ) );
+    std::vector< std::pair< Identity, Identity > > P;
+    bool ok{ true };
+    for( unsigned k = 0; k <= Config::gnosis::CHECKPOINT_DELTAS + 2; k++ ){
+      const Identity x{ E[ k*37 % E.size() ] }, s{ E[ ( k*101 + 1 ) % E.size() ] };
+      G.recover( x ).incl( G.recover( s ) );
+      P.push_back( { x, s } );
+      ok = G.checkpoint( dir.string().c_str() ) and ok;
+    }
+    check( ok, "all checkpoints written" );
+    unsigned bases{ 0 }, deltas{ 0 };
+    for( const auto& f: fs::directory_iterator( dir ) ){
+      const std::string name{ f.path().filename().string() };
+      if( name.rfind( "checkpoint.", 0 ) != 0 ) continue;
+      if( f.path().extension() == ".img" ) bases++; else deltas++;
+    }
+    check( bases == 1,                                   "single base after compaction" );
+    check( deltas < Config::gnosis::CHECKPOINT_DELTAS,   "deltas of previous generation removed" );
+    check( fs::exists( dir/"checkpoint.2.img" ),         "compacted base has next generation" );
+    Gnosis H{ "Compacted", logger };
+    bool same{ H.load( dir.string().c_str() ) and H.size() == G.size() };
+    for( const auto& [ x, s ]: P ) same = same and H.recover( x ).is( H.recover( s ) );
+    check( same, "compacted chain restored" );
+  }
+
+  void background( Logger& logger ){
+                                                                                                                              /*
+    Background checkpoint contains the graph of the moment it posted; graph modified while
+    it written:
+                                                                                                                              */
+    const std::filesystem::path dir{ folder( "background" ) };
+    Gnosis     G{ "Background", logger };
+    Data::Mini D{ "Data", logger, G };
+    std::vector< Identity > E;
+    for( unsigned i = 0; i < 10000; i++ ){
+      auto X{ G.entity() };
+      if( not E.empty() ) X.incl( G.recover( E[ i*7 % E.size() ] ) );
+      E.push_back( Identity( X ) );
+    }
+    D.put( D.key( E[0], E[1] ), Data::Cargo( int64_t( 1 ) ) );
+    const size_t N{ G.size() };
+    check( G.checkpointInBackground( dir.string().c_str(), nullptr, 0 ), "background checkpoint posted" );
+    auto A{ G.entity() };
+    G.recover( E[1] ).incl( A );
+    D.put( D.key( E[0], E[1] ), Data::Cargo( int64_t( 2 ) ) );
+    check( G.checkpoint( dir.string().c_str() ),         "checkpoint written after background one" );
+    D.put( D.key( E[0], E[1] ), Data::Cargo( int64_t( 3 ) ) );
+    check( G.checkpointInBackground( dir.string().c_str(), nullptr, 0 ), "next background checkpoint posted" );
+    D.put( D.key( E[0], E[1] ), Data::Cargo( int64_t( 4 ) ) );
+    auto B{ G.entity() };
+    check( G.waitCheckpoint() and not G.checkpointing(), "background checkpoint written" );
+    Gnosis     H{ "Restored", logger };
+    Data::Mini M{ "Data", logger, H };
+    const bool loaded{ H.load( dir.string().c_str() ) };
+    const Data::Cargo* v{ M.get( M.key( E[0], E[1] ) ) };
+    check( loaded and H.size() == N + 1,                         "background checkpoint restored" );
+    check( loaded and H.recover( E[2] ).is( H.recover( E[0] ) ),  "restored graph has signs" );
+    check( loaded and H.recover( E[1] ).is( H.recover( Identity( A ) ) ), "modification before posting checkpointed" );
+    check( loaded and not H.exists( Identity( B ) ),              "entity created after posting not checkpointed" );
+    check( loaded and v and v->integer == 3,                      "data of the moment of posting checkpointed" );
+  }
+
+  void columns( Logger& logger ){
+                                                                                                                              /*
+    Column mirrors values of the attribute: aggregates over it match aggregates over the storage
+    after puts, replacements and removals:
+                                                                                                                              */
+    Gnosis     G{ "Columns", logger };
+    Data::Mini D{ "Data", logger, G };
+    const Identity I{ Identity( G.entity() ) }, R{ Identity( G.entity() ) };
+    D.columnar( I, 'i' );
+    std::vector< Identity > O;
+    std::mt19937_64 random{ 1 };
+    for( unsigned i = 0; i < 1000; i++ ){
+      O.push_back( Identity( G.entity() ) );
+      D.put( D.key( O.back(), I ), Data::Cargo( int64_t( random() % 2001 ) - 1000 ) );
+      D.put( D.key( O.back(), R ), Data::Cargo( double( random() % 1000 )/8.0 ) );
+    }
+    D.columnar( R, 'r' ); // :filled from the current content
+    for( unsigned i = 0; i < 1000; i += 3 ) D.put( D.key( O[i], I ), Data::Cargo( int64_t( i ) ) );
+    for( unsigned i = 1; i < 1000; i += 5 ) D.excl( D.key( O[i], R ) );
+    D.put( D.key( O[2], R ), Data::Cargo( "not a number" ) ); // :not mirrored
+    Data::Summary< int64_t > si;
+    Data::Summary< double  > sr;
+    D.objects( I, [&]( const Identity&, const Data::Cargo& v ){
+      si.count++; si.sum += v.integer; si.min = std::min( si.min, v.integer ); si.max = std::max( si.max, v.integer );
+    });
+    D.objects( R, [&]( const Identity&, const Data::Cargo& v ){
+      if( v.type() != 'r' ) return;
+      sr.count++; sr.sum += v.rational; sr.min = std::min( sr.min, v.rational ); sr.max = std::max( sr.max, v.rational );
+    });
+    auto ci{ D.integer ( I ) };
+    auto cr{ D.rational( R ) };
+    check( ci and cr, "columns created" );
+    if( not ci or not cr ) return;
+    const auto Si{ ci->summary() };
+    const auto Sr{ cr->summary() };
+    check( Si.count == si.count and Si.sum == si.sum and Si.min == si.min and Si.max == si.max, "integer column aggregates" );
+    check( Sr.count == sr.count and Sr.sum == sr.sum and Sr.min == sr.min and Sr.max == sr.max, "rational column aggregates" );
+    check( ci->get( O[3] ) and *ci->get( O[3] ) == 3 and not cr->get( O[1] ) and not cr->get( O[2] ),
+           "column follows replacement and removal" );
+    size_t binned{ 0 };
+    for( const size_t n: cr->histogram( 0.0, 125.0, 10 ) ) binned += n;
+    check( binned == sr.count, "histogram covers all values" );
+  }
+
+  void ranges( Logger& logger ){
+                                                                                                                              /*
+    Selection by the range index gives the same objects as scan of the attribute without index:
+                                                                                                                              */
+    Gnosis     G{ "Ranges", logger };
+    Data::Mini D{ "Data", logger, G };
+    const Identity I{ Identity( G.entity() ) }, R{ Identity( G.entity() ) };
+    const Identity Is{ Identity( G.entity() ) }, Rs{ Identity( G.entity() ) }; // :same values, not indexed
+    D.indexed( I, 'i' );
+    std::mt19937_64 random{ 2 };
+    std::vector< Identity > O;
+    auto put = [&]( Identity obj, int64_t i, double r ){
+      D.put( D.key( obj, I ), Data::Cargo( i ) ); D.put( D.key( obj, Is ), Data::Cargo( i ) );
+      D.put( D.key( obj, R ), Data::Cargo( r ) ); D.put( D.key( obj, Rs ), Data::Cargo( r ) );
+    };
+    for( unsigned i = 0; i < 2000; i++ ){
+      O.push_back( Identity( G.entity() ) );
+      put( O.back(), int64_t( random() % 500 ), double( random() % 10000 )/100.0 );
+    }
+    D.indexed( R, 'r' ); // :filled from the current content
+    for( unsigned i = 0; i < 2000; i += 7 ) put( O[i], int64_t( 1000 + i ), -double( i ) );
+    for( unsigned i = 3; i < 2000; i += 11 ){
+      D.excl( D.key( O[i], I ) ); D.excl( D.key( O[i], Is ) );
+      D.excl( D.key( O[i], R ) ); D.excl( D.key( O[i], Rs ) );
+    }
+    bool same{ true };
+    for( int64_t lo = -10; lo < 1500; lo += 97 ){
+      same = same and D.selectIntegers ( I, lo, lo + 50 ) == D.selectIntegers( Is, lo, lo + 50 );
+      same = same and D.selectRationals( R, lo/10.0, lo/10.0 + 20.0 ) == D.selectRationals( Rs, lo/10.0, lo/10.0 + 20.0 );
+    }
+    check( same,                                                          "indexed selection matches scan" );
+    check( D.selectIntegers( I, 1000, 1000 ) == std::vector< Identity >{ O[0] }, "replaced value selected" );
+    size_t kept{ 0 };
+    for( unsigned i = 0; i < 2000; i += 7 ) if( i % 11 != 3 ) kept++;
+    check( D.selectIntegers( I, 1000, 3000 ).size() == kept,              "removed values not selected" );
+  }
+
+  void intervals( Logger& logger ){
+                                                                                                                              /*
+    Stabbing, overlap and join over the interval index give the same results as brute force
+    (ends included), also after replacement of spans and removal of values:
+                                                                                                                              */
+    Gnosis     G{ "Intervals", logger };
+    Data::Mini D{ "Data", logger, G };
+    const Identity A{ Identity( G.entity() ) }, B{ Identity( G.entity() ) };
+    std::mt19937_64 random{ 3 };
+    std::vector< Identity > O;
+    std::map< Identity, Span > a, b;
+    auto span = [&](){ const double o( random() % 1000 ); return Span( o, o + double( random() % 50 ) ); };
+    for( unsigned i = 0; i < 500; i++ ){
+      O.push_back( Identity( G.entity() ) );
+      D.put( D.key( O.back(), A ), a[ O.back() ] = span() );
+      if( i % 3 == 0 ) D.put( D.key( O.back(), B ), b[ O.back() ] = span() );
+    }
+    for( unsigned i = 0; i < 500; i += 10 ) D.put( D.key( O[i], A ), a[ O[i] ] = span() );
+    for( unsigned i = 5; i < 500; i += 10 ){ D.excl( D.key( O[i], A ) ); a.erase( O[i] ); }
+    auto common = []( const Span& x, const Span& y ){ return x.o <= y.t and y.o <= x.t; };
+    bool stabbed{ true }, overlapped{ true };
+    for( double x = -5.0; x < 1060.0; x += 13.5 ){
+      std::vector< Identity > found, expected;
+      D.stab( A, x, [&]( const Identity& obj, const Span& ){ found.push_back( obj ); } );
+      for( const auto& [ obj, S ]: a ) if( S.contains( x ) ) expected.push_back( obj );
+      std::sort( found.begin(), found.end() );
+      stabbed = stabbed and found == expected;
+      found.clear(); expected.clear();
+      const Span W( x, x + 20.0 );
+      D.overlap( A, W, [&]( const Identity& obj, const Span& ){ found.push_back( obj ); } );
+      for( const auto& [ obj, S ]: a ) if( common( S, W ) ) expected.push_back( obj );
+      std::sort( found.begin(), found.end() );
+      overlapped = overlapped and found == expected;
+    }
+    check( stabbed,    "stabbing matches brute force" );
+    check( overlapped, "overlap matches brute force" );
+    std::set< std::pair< Identity, Identity > > joined, expected;
+    bool affinity{ true };
+    D.join( A, B, [&]( const Identity& x, const Identity& y, Affinity f ){
+      joined.insert( { x, y } );
+      affinity = affinity and a.contains( x ) and b.contains( y ) and f == a[x]/b[y];
+    });
+    for( const auto& [ x, Sx ]: a ) for( const auto& [ y, Sy ]: b ) if( common( Sx, Sy ) ) expected.insert( { x, y } );
+    check( joined == expected, "join matches brute force" );
+    check( affinity,           "join reports affinity of the spans" );
+  }
+
+  void names( Logger& ){
+                                                                                                                              /*
+    Random let / forget of names agree with reference maps while forgotten records pile up past
+    the compaction threshold; prefix completion and approximate lookup give the same names as
+    brute-force scans of the reference:
+                                                                                                                              */
+    Names N;
+    std::map< Identity, std::string > R; // :reference ID -> name
+    std::map< std::string, Identity > L; // :reference name -> ID
+    std::mt19937 random{ 6 };
+    auto word = [&]( size_t length ){
+      std::string w;
+      for( size_t i = 0; i < length; i++ ) w.push_back( "abcd"[ random() % 4 ] );
+      return w;
+    };
+    auto levenshtein = []( std::string_view a, std::string_view b ){
+      std::vector< unsigned > row( b.size() + 1 );
+      for( size_t j = 0; j <= b.size(); j++ ) row[j] = unsigned( j );
+      for( size_t i = 1; i <= a.size(); i++ ){
+        unsigned diagonal{ row[0] };
+        row[0] = unsigned( i );
+        for( size_t j = 1; j <= b.size(); j++ ){
+          const unsigned up{ row[j] };
+          row[j] = std::min( { row[j] + 1, row[j-1] + 1, diagonal + ( a[i-1] == b[j-1] ? 0u : 1u ) } );
+          diagonal = up;
+        }
+      }
+      return row[ b.size() ];
+    };
+    auto same = [&](){
+      bool ok{ N.size() == R.size() };
+      for( const auto& [ id, name ]: R ) ok = ok and N.lex( id ) == name and N.find( name ) == id;
+      size_t n{ 0 };
+      N.each( [&]( Identity id, std::string_view name ){ n++; ok = ok and R.count( id ) and R[ id ] == name; } );
+      return ok and n == R.size();
+    };
+    auto prefixes = [&](){
+      bool ok{ true };
+      for( unsigned q = 0; q < 200; q++ ){
+        const std::string prefix{ word( random() % 5 ) };
+        const size_t      limit { 1 + random() % 20 };
+        std::vector< std::pair< Identity, std::string > > got, expected;
+        N.complete( prefix, limit, [&]( Identity id, std::string_view name ){ got.emplace_back( id, name ); } );
+        std::string lcp;
+        bool        first{ true };
+        for( auto it = L.lower_bound( prefix ); it != L.end() and it->first.starts_with( prefix ); ++it ){
+          if( expected.size() < limit ) expected.emplace_back( it->second, it->first );
+          if( first ) lcp = it->first; else lcp.resize( std::mismatch( lcp.begin(), lcp.end(), it->first.begin(), it->first.end() ).first - lcp.begin() );
+          first = false;
+        }
+        ok = ok and got == expected and N.common( prefix ) == lcp;
+      }
+      return ok;
+    };
+    auto similar = [&](){
+      bool ok{ true };
+      for( unsigned q = 0; q < 100; q++ ){
+        std::string pattern{ word( 1 + random() % 14 ) };
+        if( q % 2 and not R.empty() ){ // :near existing name
+          pattern = std::next( R.begin(), random() % R.size() )->second;
+          pattern[ random() % pattern.size() ] = 'e';
+        }
+        const unsigned k    { unsigned( random() % 4 ) };
+        const size_t   limit{ 1 + random() % 10 };
+        std::vector< std::tuple< unsigned, std::string, Identity > > got, expected;
+        N.similar( pattern, k, limit, [&]( Identity id, std::string_view name, unsigned d ){ got.emplace_back( d, name, id ); } );
+        for( const auto& [ name, id ]: L ) if( const unsigned d{ levenshtein( pattern, name ) }; d <= k ) expected.emplace_back( d, name, id );
+        std::sort( expected.begin(), expected.end() );
+        if( expected.size() > limit ) expected.resize( limit );
+        ok = ok and got == expected;
+      }
+      return ok;
+    };
+    bool   agree{ true }, found{ true }, complete{ true }, approximate{ true };
+    size_t peak{ 0 }, compacted{ 0 };
+    for( unsigned i = 1; i <= 150000; i++ ){
+      const Identity id{ Identity( 1 + random() % 4000 ) };
+      if( random() % 5 ){
+        const std::string name{ word( random() % 25 ) };
+        if( const auto it{ R.find( id ) }; it != R.end() ){ L.erase( it->second ); R.erase( it ); }
+        if( not name.empty() ){
+          if( const auto it{ L.find( name ) }; it != L.end() ){ R.erase( it->second ); L.erase( it ); }
+          R[ id ] = name;
+          L[ name ] = id;
+        }
+        N.let( id, name );
+      } else {
+        const bool named{ R.count( id ) > 0 };
+        if( named ){ L.erase( R[ id ] ); R.erase( id ); }
+        found = found and N.forget( id ) == named;
+      }
+      if( N.bytes() < peak ) compacted++;
+      peak = N.bytes();
+      if( i % 30000 == 0 ){
+        agree       = agree       and same    ();
+        complete    = complete    and prefixes();
+        approximate = approximate and similar ();
+      }
+    }
+    check( agree and found,  "names agree with reference maps" );
+    check( compacted > 0,    "forgotten names compacted" );
+    check( complete,         "complete and common match brute-force prefix scan" );
+    check( approximate,      "similar matches brute-force Levenshtein scan" );
+  }
+
+  void glossary( Logger& logger ){
+                                                                                                                              /*
+    Binary image and text file of the glossary loaded by other glossary of the same graph give
+    the same names; damaged image rejected without change of the glossary:
+                                                                                                                              */
+    namespace fs = std::filesystem;
+    const fs::path dir{ folder( "glossary" ) };
+    Gnosis     G{ "Glossary", logger };
+    Data::Mini D{ "Data", logger, G };
+    Glossary   E{ "EN", logger, G, D };
+    std::vector< std::pair< std::string, Identity > > N;
+    for( unsigned i = 0; i < 3000; i++ ){
+      const std::string name{ i % 7 ? "name " + std::to_string( i ) : "ñame-" + std::to_string( i ) };
+      N.push_back( { name, Identity( E.entity( name ) ) } );
+    }
+    const std::string image{ ( dir/Config::glossary::IMAGE ).string() }, text{ ( dir/"glossary.txt" ).string() };
+    check( E.image( image.c_str() ) and E.save( text.c_str() ), "glossary image and text saved" );
+    auto same = [&]( Glossary& K ){
+      const size_t size{ K.size() };
+      bool ok{ size == E.size() };
+      for( const auto& [ name, id ]: N ) ok = ok and Identity( K.entity( name ) ) == id;
+      return ok and K.size() == size and K.complete( "name 12" ) == E.complete( "name 12" );
+    };
+    {
+      Glossary K{ "Image", logger, G, D };
+      check( K.load( image.c_str() ) and same( K ), "glossary image round-trip" );
+                                                                                                                              /*
+      Header claims more names than the file has; rejected before allocation:
+                                                                                                                              */
+      const fs::path damaged{ dir/"damaged.img" };
+      fs::copy_file( image, damaged );
+      FILE* f{ fopen( damaged.string().c_str(), "r+b" ) };
+      const uint64_t huge{ uint64_t( 1 ) << 60 };
+      const bool     written{ f and fseek( f, 16, SEEK_SET ) == 0 and fwrite( &huge, sizeof( huge ), 1, f ) == 1 };
+      if( f ) fclose( f );
+      check( written and not K.load( damaged.string().c_str() ) and same( K ), "glossary header claiming more names rejected" );
+      fs::resize_file( image, fs::file_size( image ) - 1 );
+      check( not K.load( image.c_str() ) and same( K ), "damaged glossary image rejected, names kept" );
+    }
+    {
+      Glossary K{ "Text", logger, G, D };
+      check( K.load( text.c_str() ) and same( K ), "glossary text round-trip" );
+    }
+    check( G.save( ( dir/"saved" ).string().c_str() ) and G.checkpoint( ( dir/"chain" ).string().c_str() ),
+           "glossary saved with graph image and checkpoint" );
+    for( const char* kind: { "saved", "chain" } ){
+      Gnosis     H{ "Restored", logger };
+      Data::Mini M{ "Data", logger, H };
+      Glossary   K{ "EN", logger, H, M };
+      check( H.load( ( dir/kind ).string().c_str() ) and same( K ), "glossary restored with the graph" );
+    }
+  }
+
+  void analogic( Logger& logger ){
+                                                                                                                              /*
+    Parallel search of analogs (candidate adjacency, join of the lists, arc consistency, work
+    stealing) finds every 4-cycle of the layered graph exactly once, as brute force does; search
+    over snapshot gives the same results:
+                                                                                                                              */
+    Gnosis G{ "Analogic", logger };
+    std::mt19937 random{ 5 };
+    const unsigned K{ 200 };
+    auto A{ G.entity() }, B{ G.entity() }, C{ G.entity() }, D{ G.entity() };
+    std::vector< Gnosis::Entity > X, Y, Z, W;
+    for( unsigned k = 0; k < K; k++ ){
+      X.push_back( G.entity() ); X.back().incl( A );
+      Y.push_back( G.entity() ); Y.back().incl( B );
+      Z.push_back( G.entity() ); Z.back().incl( C );
+      W.push_back( G.entity() ); W.back().incl( D );
+    }
+    auto any = [&](){ return 1 + random() % ( K - 1 ); }; // :never pattern element
+    for( unsigned k = 0; k < K; k++ ){
+      if( k % 7 == 0 ){ X[k].incl( Y[k] ); Y[k].incl( Z[k] ); Z[k].incl( W[k] ); X[k].incl( W[k] ); }
+      const unsigned m{ k < 20 ? 50u : 3u }; // :skewed fan-out
+      if( k ) for( unsigned j = 0; j < m; j++ ) X[k].incl( Y[ any() ] );
+      for( unsigned j = 0; j < m;  j++ ) Y[ any() ].incl( Z[ any() ] );
+      for( unsigned j = 0; j < 15; j++ ) Z[ any() ].incl( W[ any() ] );
+    }
+    using Tuple = std::vector< Identity >;
+    std::set< Tuple > expected;
+    for( unsigned x = 1; x < K; x++ ) for( unsigned y = 1; y < K; y++ ){
+      if( not X[x].is( Y[y] ) ) continue;
+      for( unsigned z = 1; z < K; z++ ){
+        if( not Y[y].is( Z[z] ) ) continue;
+        for( unsigned w = 1; w < K; w++ ) if( Z[z].is( W[w] ) and X[x].is( W[w] ) )
+          expected.insert( { Identity( X[x] ), Identity( Y[y] ), Identity( Z[z] ), Identity( W[w] ) } );
+      }
+    }
+    auto P{ G.sequence() };
+    P += X[0]; P += Y[0]; P += Z[0]; P += W[0];
+    auto search = [&]( const Gnosis::Snapshot* view ){
+      std::mutex           mutex;
+      std::vector< Tuple > found;
+      auto f = [&]( const Gnosis::Sequence& q )->bool{
+        Tuple t;
+        for( unsigned i = 0; i < q.size(); i++ ) t.push_back( Identity( q[i] ) );
+        std::lock_guard< std::mutex > lock( mutex );
+        found.push_back( t );
+        return true;
+      };
+      auto lex = []( Identity id ){ return std::to_string( id ); };
+      if( view ) G.analogic( *view, P, G.syndrome(), f, lex );
+      else       G.analogic(        P, G.syndrome(), f, lex );
+      return found;
+    };
+    bool exact{ true }, unique{ true };
+    for( unsigned run = 0; run < 3; run++ ){
+      const auto found{ search( nullptr ) };
+      const std::set< Tuple > S( found.begin(), found.end() );
+      unique = unique and S.size() == found.size();
+      exact  = exact  and S == expected;
+    }
+    check( not expected.empty(), "graph has analogs" );
+    check( exact,                "analogs match brute force" );
+    check( unique,               "each analog found once" );
+    const auto view { G.snapshot() };
+    X[1].incl( Y[1] ); Y[1].incl( Z[1] ); Z[1].incl( W[1] ); X[1].incl( W[1] ); // :not seen by snapshot
+    const auto found{ search( &view ) };
+    check( std::set< Tuple >( found.begin(), found.end() ) == expected, "analogs over snapshot" );
+  }
+
+}//namespace
+
+int main(){
+
+  static Logger logger{}; // :too large for the stack together with graphs
+  logger.update( logging::Note::Type::BRIEF, "test.brief" );
+
+  snapshot  ( logger );
+  batch     ( logger );
+  journal   ( logger );
+  image     ( logger );
+  data      ( logger );
+  scans     ( logger );
+  morton    ( logger );
+  compaction( logger );
+  background( logger );
+  columns   ( logger );
+  ranges    ( logger );
+  intervals ( logger );
+  names     ( logger );
+  glossary  ( logger );
+  analogic  ( logger );
+
+  printf( "\n %u checks passed, %u failed\n", passed, failed );
+  return int( failed );
+}